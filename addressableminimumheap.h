@@ -0,0 +1,273 @@
+#ifndef ADDRESSABLEMINIMUMHEAP_H
+#define ADDRESSABLEMINIMUMHEAP_H
+
+#include <vector>
+#include <ostream>
+#include <iostream>
+#include <functional>
+#include "minimumheap.h"
+#include "minimumheapsift.h"
+
+/**
+ * @brief Exception: A handle has been used that does not refer to an element
+ * currently in the AddressableMinimumHeap.
+ */
+class MinimumHeapInvalidHandleException {};
+
+/**
+ * @brief Exception: A key change has been attempted in the wrong direction (e.g.
+ * decreasing the key of an element to a larger value).
+ */
+class MinimumHeapInvalidKeyException {};
+
+/**
+ * A minimum heap of Comparable elements that can be addressed after insertion.
+ * Each insert produces a Handle which refers to the inserted element for as
+ * long as it remains in the heap, no matter how it moves within the heap. The
+ * handle can be used to inspect the element, decrease or increase its value,
+ * or erase it from the heap in O(log n).
+ *
+ * The layout of the heap and the sifting of its elements are shared with
+ * MinimumHeap (see MinimumHeapSift); each element additionally carries the
+ * index of its slot in a table of positions which is kept up to date as the
+ * element moves. Containers that never need to address their elements should
+ * use MinimumHeap which does not pay for this bookkeeping.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          MinimumHeapPop Pop = MinimumHeapPop::TopDown,
+          typename Compare = std::less<Comparable>> class AddressableMinimumHeap {
+
+public:
+
+    /**
+     * Refers to an element of the AddressableMinimumHeap. A handle remains
+     * valid until its element is popped or erased from the heap, or the heap
+     * is cleared; a handle whose slot has since been reused is detected by its
+     * generation.
+     */
+    class Handle {
+        friend class AddressableMinimumHeap;
+        size_t _slot = 0;
+        size_t _generation = 0;
+        Handle ( size_t slot, size_t generation )
+            : _slot{ slot }, _generation{ generation } {}
+    public:
+        Handle() = default;
+        bool operator== ( const Handle& rhs ) const
+            { return _slot == rhs._slot && _generation == rhs._generation; }
+        bool operator!= ( const Handle& rhs ) const { return !( *this == rhs ); }
+    };
+
+private:
+
+    /** An element of the heap with the slot holding its position. **/
+    struct Entry {
+        Comparable value;
+        size_t slot;
+    };
+
+    /** The position of an element in the heap and the generation of the slot. **/
+    struct Slot {
+        size_t position;
+        size_t generation;
+    };
+
+    /** Orders entries by their values. **/
+    struct EntryLess {
+        Compare compare;
+        bool operator() ( const Entry& lhs, const Entry& rhs ) { return compare ( lhs.value, rhs.value ); }
+    };
+
+    /** Records the new position of each entry as it is moved by a sift. **/
+    struct SlotUpdate {
+        AddressableMinimumHeap* heap;
+        void operator() ( size_t index )
+            { heap->_slots[heap->_elements[index].slot].position = index; }
+    };
+
+    /** The sift engine for the Arity of the heap. **/
+    typedef MinimumHeapSift<Arity> Sift;
+
+    /** The marker for the position of a slot which is not in use. **/
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /** The entries of the heap arranged in a vector. **/
+    std::vector<Entry> _elements;
+
+    /** The positions of the entries, indexed by slot. **/
+    std::vector<Slot> _slots;
+
+    /** The slots that are not currently in use. **/
+    std::vector<size_t> _freeSlots;
+
+    /** The function object used to order the entries. **/
+    EntryLess _less;
+
+    /**
+     * Produces the position of the element referred to by the given handle.
+     * @param handle: the handle of the element.
+     * @return the index of the element in the heap.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     */
+    size_t position ( const Handle& handle ) const;
+
+    /**
+     * Moves the element at the given index up or down in the heap as
+     * necessary to preserve the minimum property of the heap.
+     * @param index: the index of the element to reposition.
+     */
+    void restore ( size_t index );
+
+    /**
+     * Removes the element at the given index from the heap, releasing its slot.
+     * @param index: the index of the element to remove.
+     * @return the removed element.
+     */
+    Comparable remove ( size_t index );
+
+public:
+
+    /**
+     * Instantiate an AddressableMinimumHeap given the initial capacity
+     * (default = 2) of the underlying vectors.
+     * @param capacity: the initial capacity.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit AddressableMinimumHeap ( size_t capacity = 2, const Compare& compare = Compare() );
+
+    /**
+     * Produces the current size of the AddressableMinimumHeap.
+     * @return number of elements in the AddressableMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the AddressableMinimumHeap is empty (it contains no elements).
+     * @return true if the AddressableMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Resets the AddressableMinimumHeap to be empty. All existing handles
+     * become invalid.
+     */
+    void clear();
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Produces the handle of the element at the top of the heap.
+     * @return the handle of the smallest element.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    Handle top_handle ( ) const;
+
+    /**
+     * Inserts the given element into the heap at the appropriate position
+     * such that the minimum property of the heap is preserved.
+     * @param element: the element to be inserted into the heap
+     * @return the handle of the inserted element.
+     */
+    Handle insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it to the appropriate
+     * position such that the minimum property of the heap is preserved.
+     * @param element: the element to be inserted (moved) into the heap
+     * @return the handle of the inserted element.
+     */
+    Handle insert ( Comparable&& element );
+
+    /**
+     * Determines if the given handle refers to an element in the heap.
+     * @param handle: the handle to check.
+     * @return true if the element is still in the heap, false otherwise.
+     */
+    bool contains ( const Handle& handle ) const;
+
+    /**
+     * Produces the element referred to by the given handle.
+     * @param handle: the handle of the element.
+     * @return the value of the element.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     */
+    const Comparable& value ( const Handle& handle ) const;
+
+    /**
+     * Replaces the element referred to by the given handle with a value that
+     * is not larger, moving it up in the heap as necessary.
+     * @param handle: the handle of the element.
+     * @param element: the new value of the element.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     * @throws MinimumHeapInvalidKeyException if the new value is larger.
+     */
+    void decrease_key ( const Handle& handle, const Comparable& element );
+
+    /**
+     * Replaces the element referred to by the given handle with a value that
+     * is not smaller, moving it down in the heap as necessary.
+     * @param handle: the handle of the element.
+     * @param element: the new value of the element.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     * @throws MinimumHeapInvalidKeyException if the new value is smaller.
+     */
+    void increase_key ( const Handle& handle, const Comparable& element );
+
+    /**
+     * Replaces the element referred to by the given handle with any value,
+     * moving it up or down in the heap as necessary.
+     * @param handle: the handle of the element.
+     * @param element: the new value of the element.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     */
+    void update ( const Handle& handle, const Comparable& element );
+
+    /**
+     * Removes the element referred to by the given handle from the heap.
+     * @param handle: the handle of the element.
+     * @return the value of the removed element.
+     * @throws MinimumHeapInvalidHandleException if the handle is not valid.
+     */
+    Comparable erase ( const Handle& handle );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap preserving the minimum property
+     * of the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    Comparable pop ();
+
+    /**
+     * Produces the elements in the heap to the given output stream. The
+     * format of the output is such that the heap with elements 1, 2, 3, 4,
+     * and 5 will be outputted as "AddressableMinimumHeap [1, 2, 3, 4, 5]"
+     * @param out: the output stream to be updated.
+     */
+    void output ( std::ostream& out = std::cout ) const;
+
+};
+
+/**
+ * Produces the elements in the AddressableMinimumHeap to the given output
+ * stream. The format of the output is such that the heap with elements 1, 2,
+ * 3, 4, and 5 will be outputted as "AddressableMinimumHeap [1, 2, 3, 4, 5]"
+ * @param out: the output stream to be updated.
+ */
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+std::ostream& operator<< (std::ostream& out, const AddressableMinimumHeap<Comparable, Arity, Pop, Compare>& h);
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "addressableminimumheap.tpp"
+
+#endif // ADDRESSABLEMINIMUMHEAP_H
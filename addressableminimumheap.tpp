@@ -0,0 +1,205 @@
+#include "addressableminimumheap.h"
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::position ( const Handle& handle ) const
+{
+    if ( !contains ( handle ) ) { throw MinimumHeapInvalidHandleException(); }
+    return _slots[handle._slot].position;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::restore ( size_t index )
+{
+    SlotUpdate placed { this };
+    Entry entry = std::move ( _elements[index] );
+    if ( index > 0 && _less ( entry, _elements[Sift::parent ( index )] ) )
+        Sift::siftUp ( _elements.data(), 0, index, std::move ( entry ), _less, placed );
+    else
+        Sift::siftDown ( _elements.data(), _elements.size(), index, std::move ( entry ), _less, placed );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::remove ( size_t index )
+{
+    Entry removed = std::move ( _elements[index] );
+    Slot& slot = _slots[removed.slot];
+    slot.position = npos;
+    slot.generation++;
+    _freeSlots.push_back ( removed.slot );
+
+    Entry last = std::move ( _elements.back() );
+    _elements.pop_back();
+    if ( index < _elements.size() )
+    {
+        SlotUpdate placed { this };
+        if ( index > 0 && _less ( last, _elements[Sift::parent ( index )] ) )
+            Sift::siftUp ( _elements.data(), 0, index, std::move ( last ), _less, placed );
+        else
+            Sift::template fillHole<Pop> ( _elements.data(), _elements.size(), index,
+                                           std::move ( last ), _less, placed );
+    }
+    return std::move ( removed.value );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::AddressableMinimumHeap ( size_t capacity, const Compare& compare )
+    : _less{ compare }
+{
+    _elements.reserve ( capacity );
+    _slots.reserve ( capacity );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::size() const
+{
+    return _elements.size();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::empty() const
+{
+    return _elements.empty();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::clear()
+{
+    _freeSlots.clear();
+    for ( size_t slot = 0; slot < _slots.size(); slot++ )
+    {
+        if ( _slots[slot].position != npos )
+        {
+            _slots[slot].position = npos;
+            _slots[slot].generation++;
+        }
+        _freeSlots.push_back ( slot );
+    }
+    _elements.clear();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _elements[0].value;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::top_handle ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    size_t slot = _elements[0].slot;
+    return Handle ( slot, _slots[slot].generation );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::insert ( const Comparable& element )
+{
+    Comparable copy = element;
+    return insert ( std::move ( copy ) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::insert ( Comparable&& element )
+{
+    size_t slot;
+    if ( _freeSlots.empty() )
+    {
+        slot = _slots.size();
+        _slots.push_back ( Slot { npos, 0 } );
+    }
+    else
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+
+    SlotUpdate placed { this };
+    _elements.push_back ( Entry { std::move ( element ), slot } );
+    Entry entry = std::move ( _elements.back() );
+    Sift::siftUp ( _elements.data(), 0, _elements.size() - 1, std::move ( entry ), _less, placed );
+    return Handle ( slot, _slots[slot].generation );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::contains ( const Handle& handle ) const
+{
+    return handle._slot < _slots.size()
+            && _slots[handle._slot].generation == handle._generation
+            && _slots[handle._slot].position != npos;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::value ( const Handle& handle ) const
+{
+    return _elements[position ( handle )].value;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::decrease_key ( const Handle& handle,
+                                                                    const Comparable& element )
+{
+    size_t index = position ( handle );
+    if ( _less.compare ( _elements[index].value, element ) ) { throw MinimumHeapInvalidKeyException(); }
+
+    SlotUpdate placed { this };
+    Entry entry { element, handle._slot };
+    Sift::siftUp ( _elements.data(), 0, index, std::move ( entry ), _less, placed );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::increase_key ( const Handle& handle,
+                                                                    const Comparable& element )
+{
+    size_t index = position ( handle );
+    if ( _less.compare ( element, _elements[index].value ) ) { throw MinimumHeapInvalidKeyException(); }
+
+    SlotUpdate placed { this };
+    Entry entry { element, handle._slot };
+    Sift::siftDown ( _elements.data(), _elements.size(), index, std::move ( entry ), _less, placed );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::update ( const Handle& handle,
+                                                              const Comparable& element )
+{
+    size_t index = position ( handle );
+    _elements[index].value = element;
+    restore ( index );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::erase ( const Handle& handle )
+{
+    return remove ( position ( handle ) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::pop ()
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return remove ( 0 );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void AddressableMinimumHeap<Comparable, Arity, Pop, Compare>::output ( std::ostream& out ) const
+{
+    out << "AddressableMinimumHeap [";
+    for (size_t i=0; i<_elements.size(); i++) {
+      if ( i > 0 )
+        out << ", ";
+      out << _elements[i].value;
+    }
+    out << "]";
+    out.flush();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+std::ostream& operator<< (std::ostream& out, const AddressableMinimumHeap<Comparable, Arity, Pop, Compare>& h)
+{
+    h.output(out);
+    return out;
+}
@@ -0,0 +1,331 @@
+#ifndef ASYNCMINIMUMHEAP_H
+#define ASYNCMINIMUMHEAP_H
+
+#if !defined(__cpp_impl_coroutine)
+#error "AsyncMinimumHeap requires C++20 coroutines"
+#endif
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "minimumheap.h"
+#include "tombstoneminimumheap.h"
+
+/**
+ * A priority queue of Comparable elements whose consumers wait for elements
+ * by suspending a coroutine rather than a thread, for executors which order
+ * their ready tasks by priority: an idle worker co_awaits pop() instead of
+ * polling empty().
+ *
+ * The elements are held in a MinimumHeap. A consumer awaiting pop() on an
+ * empty queue is suspended and queued; insert hands the smallest element to
+ * the consumer waiting longest and has the Executor resume it, so waiting
+ * consumers receive the elements in priority order, and each element goes to
+ * exactly one consumer. insert_range wakes as many consumers as it supplies
+ * elements for, under a single lock (a batched wakeup). pop_for gives up
+ * after a timeout, producing no element.
+ *
+ * The Executor resumes the consumers (never inline, in insert) and runs the
+ * timers of pop_for, cancelling the timer of a consumer served before its
+ * timeout. It must provide:
+ *
+ *     void post ( F callback );            // calls callback() later
+ *     TimerHandle post_after ( std::chrono::nanoseconds delay, F callback );
+ *     void cancel ( const TimerHandle& timer );  // the callback is not called
+ *
+ * for any function object F, neither of which calls the callback before it
+ * returns; cancel does nothing if the timer has already run.
+ * MinimumHeapManualExecutor is a deterministic, single-threaded executor with
+ * a virtual clock for tests.
+ *
+ * The queue is safe to use from several threads. It must outlive its waiting
+ * consumers and the timers of pop_for, and a waiting consumer must not be
+ * destroyed before it is resumed.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, typename Executor,
+          typename Compare = std::less<Comparable>> class AsyncMinimumHeap {
+
+private:
+
+    /** A suspended consumer, the element handed to it, if any, and the timer
+     * of its timeout (pop_for). **/
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        std::optional<Comparable> value;
+        std::optional<typename Executor::TimerHandle> timer;
+        bool done = false;
+        typename std::list<std::shared_ptr<Waiter>>::iterator position;
+    };
+
+    /** The elements of the queue. **/
+    MinimumHeap<Comparable, 2, MinimumHeapPop::TopDown, Compare> _heap;
+
+    /** The suspended consumers, the longest waiting first. **/
+    std::list<std::shared_ptr<Waiter>> _waiters;
+
+    /** The executor resuming the consumers. **/
+    Executor& _executor;
+
+    /** Guards the elements and the consumers. **/
+    mutable std::mutex _mutex;
+
+    /**
+     * Hands the smallest elements to the longest waiting consumers, while
+     * both remain. Called with the mutex held.
+     * @param woken: receives the consumers to resume.
+     */
+    void deliver ( std::vector<std::shared_ptr<Waiter>>& woken );
+
+    /**
+     * Has the executor cancel the timers of the given consumers, if any, and
+     * resume them, in order.
+     * @param woken: the consumers to resume.
+     */
+    void wake ( const std::vector<std::shared_ptr<Waiter>>& woken );
+
+    /**
+     * Resumes the given consumer without an element, unless it has received
+     * one already (the timeout of pop_for).
+     * @param waiter: the consumer.
+     */
+    void expire ( const std::shared_ptr<Waiter>& waiter );
+
+public:
+
+    /**
+     * The awaitable produced by pop() (Timed = false), whose co_await
+     * produces the smallest element, and by pop_for() (Timed = true), whose
+     * co_await produces the smallest element or none on timeout.
+     */
+    template <bool Timed>
+    class Awaiter {
+
+        AsyncMinimumHeap& _queue;
+        std::chrono::nanoseconds _timeout;
+        std::optional<Comparable> _value;
+        std::shared_ptr<Waiter> _waiter;
+
+    public:
+
+        Awaiter ( AsyncMinimumHeap& queue, std::chrono::nanoseconds timeout );
+
+        /** Never ready: whether to suspend is decided under the lock. **/
+        bool await_ready ( ) const noexcept { return false; }
+
+        /**
+         * Takes the smallest element if there is one and no consumer waits
+         * before this one, otherwise queues the consumer.
+         * @return true if the consumer is suspended.
+         */
+        bool await_suspend ( std::coroutine_handle<> handle );
+
+        /**
+         * Produces the element taken or handed to the consumer.
+         */
+        typename std::conditional<Timed, std::optional<Comparable>, Comparable>::type await_resume ( );
+    };
+
+    /**
+     * Instantiate an empty AsyncMinimumHeap.
+     * @param executor: the executor resuming the consumers.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit AsyncMinimumHeap ( Executor& executor, const Compare& compare = Compare() );
+
+    AsyncMinimumHeap ( const AsyncMinimumHeap& rhs ) = delete;
+    AsyncMinimumHeap& operator= ( const AsyncMinimumHeap& rhs ) = delete;
+
+    /**
+     * Produces the number of elements in the queue (not yet handed out).
+     * @return number of elements in the AsyncMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the AsyncMinimumHeap holds no element.
+     * @return true if the AsyncMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Produces the number of suspended consumers.
+     * @return number of consumers waiting for an element.
+     */
+    size_t waiting() const;
+
+    /**
+     * Inserts the given element, handing it (or a smaller one) to the
+     * longest waiting consumer, if any.
+     * @param element: the element to be inserted (moved) into the queue.
+     */
+    void insert ( Comparable element );
+
+    /**
+     * Inserts the elements of the range [first, last), handing the smallest
+     * elements to as many waiting consumers, in order, which are resumed as
+     * one batch.
+     * @param first: the first element of the range.
+     * @param last: one past the last element of the range.
+     */
+    template <typename InputIterator>
+    void insert_range ( InputIterator first, InputIterator last );
+
+    /**
+     * Takes the smallest element without waiting, unless consumers are
+     * already waiting for it.
+     * @return the smallest element, or none.
+     */
+    std::optional<Comparable> try_pop ( );
+
+    /**
+     * Produces an awaitable taking the smallest element, suspending the
+     * awaiting coroutine until there is one.
+     * @return the awaitable (co_await produces a Comparable).
+     */
+    Awaiter<false> pop ( );
+
+    /**
+     * Produces an awaitable taking the smallest element, suspending the
+     * awaiting coroutine until there is one or the timeout has elapsed.
+     * @param timeout: the longest time to wait (0 does not suspend).
+     * @return the awaitable (co_await produces a std::optional<Comparable>,
+     * empty on timeout).
+     */
+    Awaiter<true> pop_for ( std::chrono::nanoseconds timeout );
+
+};
+
+/**
+ * A deterministic, single-threaded executor for testing coroutines without
+ * real I/O or time: posted callbacks run in the order posted, and only when
+ * run() is called; timers run when advance() moves the virtual clock past
+ * their deadline, in the order of their deadlines (then of posting).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+class MinimumHeapManualExecutor {
+
+    /** A callback posted to run at a time of the virtual clock. **/
+    struct Timer {
+        std::chrono::nanoseconds deadline;
+        uint64_t sequence;
+        std::function<void()> callback;
+
+        bool operator< ( const Timer& rhs ) const
+        {
+            return deadline < rhs.deadline || ( deadline == rhs.deadline && sequence < rhs.sequence );
+        }
+    };
+
+    std::deque<std::function<void()>> _ready;
+    TombstoneMinimumHeap<Timer> _timers;
+    std::chrono::nanoseconds _now { 0 };
+    uint64_t _sequence = 0;
+
+public:
+
+    /** Refers to a timer until it runs or is cancelled. **/
+    typedef TombstoneMinimumHeap<Timer>::Handle TimerHandle;
+
+    /** Queues the given callback to be run by run(). **/
+    template <typename F>
+    void post ( F callback )
+    {
+        _ready.emplace_back ( std::move ( callback ) );
+    }
+
+    /** Queues the given callback to be run once the clock has advanced by
+     * the given delay, producing the handle which cancels it. **/
+    template <typename F>
+    TimerHandle post_after ( std::chrono::nanoseconds delay, F callback )
+    {
+        return _timers.insert ( Timer { _now + delay, _sequence++, std::move ( callback ) } );
+    }
+
+    /** Drops the given timer, unless it has already run. **/
+    void cancel ( const TimerHandle& timer )
+    {
+        _timers.mark_deleted ( timer );
+    }
+
+    /** Produces the time of the virtual clock. **/
+    std::chrono::nanoseconds now ( ) const
+    {
+        return _now;
+    }
+
+    /**
+     * Runs the posted callbacks, including those they post, until none is
+     * left.
+     * @return the number of callbacks run.
+     */
+    size_t run ( )
+    {
+        size_t count = 0;
+        while ( !_ready.empty() )
+        {
+            std::function<void()> callback = std::move ( _ready.front() );
+            _ready.pop_front();
+            callback();
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * Advances the virtual clock by the given time, running each timer due
+     * on the way (and then the callbacks it posts) at its deadline.
+     * @return the number of callbacks and timers run.
+     */
+    size_t advance ( std::chrono::nanoseconds time )
+    {
+        std::chrono::nanoseconds end = _now + time;
+        size_t count = run();
+        while ( !_timers.empty() && _timers.top().deadline <= end )
+        {
+            Timer timer = _timers.pop();
+            _now = timer.deadline;
+            timer.callback();
+            count += 1 + run();
+        }
+        _now = end;
+        return count;
+    }
+
+    /** Determines if no callback and no timer (not cancelled) is queued. **/
+    bool idle ( ) const
+    {
+        return _ready.empty() && _timers.empty();
+    }
+};
+
+/**
+ * The return type of a coroutine that starts at once and is detached from
+ * its caller: its frame is destroyed when it completes (an exception escaping
+ * it terminates the program). Used to spawn consumers in tests.
+ */
+struct MinimumHeapDetachedTask {
+    struct promise_type {
+        MinimumHeapDetachedTask get_return_object ( ) noexcept { return {}; }
+        std::suspend_never initial_suspend ( ) noexcept { return {}; }
+        std::suspend_never final_suspend ( ) noexcept { return {}; }
+        void return_void ( ) noexcept {}
+        void unhandled_exception ( ) noexcept { std::terminate(); }
+    };
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "asyncminimumheap.tpp"
+
+#endif // ASYNCMINIMUMHEAP_H
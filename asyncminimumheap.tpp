@@ -0,0 +1,157 @@
+#include "asyncminimumheap.h"
+
+template <typename Comparable, typename Executor, typename Compare>
+void AsyncMinimumHeap<Comparable, Executor, Compare>::deliver ( std::vector<std::shared_ptr<Waiter>>& woken )
+{
+    while ( !_waiters.empty() && !_heap.empty() )
+    {
+        std::shared_ptr<Waiter> waiter = std::move ( _waiters.front() );
+        _waiters.pop_front();
+        waiter->value = _heap.pop();
+        waiter->done = true;
+        woken.push_back ( std::move ( waiter ) );
+    }
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+void AsyncMinimumHeap<Comparable, Executor, Compare>::wake ( const std::vector<std::shared_ptr<Waiter>>& woken )
+{
+    for ( const std::shared_ptr<Waiter>& waiter : woken )
+    {
+        if ( waiter->timer )
+            _executor.cancel ( *waiter->timer );
+        _executor.post ( waiter->handle );
+    }
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+void AsyncMinimumHeap<Comparable, Executor, Compare>::expire ( const std::shared_ptr<Waiter>& waiter )
+{
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        if ( waiter->done )
+            return;
+        waiter->done = true;
+        _waiters.erase ( waiter->position );
+    }
+    _executor.post ( waiter->handle );
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+template <bool Timed>
+AsyncMinimumHeap<Comparable, Executor, Compare>::Awaiter<Timed>::Awaiter (
+        AsyncMinimumHeap& queue, std::chrono::nanoseconds timeout )
+    : _queue { queue }, _timeout { timeout } {}
+
+template <typename Comparable, typename Executor, typename Compare>
+template <bool Timed>
+bool AsyncMinimumHeap<Comparable, Executor, Compare>::Awaiter<Timed>::await_suspend ( std::coroutine_handle<> handle )
+{
+    std::lock_guard<std::mutex> lock ( _queue._mutex );
+    if ( _queue._waiters.empty() && !_queue._heap.empty() )
+    {
+        _value = _queue._heap.pop();
+        return false;
+    }
+    if ( Timed && _timeout <= std::chrono::nanoseconds::zero() )
+        return false;
+
+    _waiter = std::make_shared<Waiter>();
+    _waiter->handle = handle;
+    _waiter->position = _queue._waiters.insert ( _queue._waiters.end(), _waiter );
+    if ( Timed )
+    {
+        // The timer is armed under the lock, so that whichever insert serves
+        // the consumer finds it to cancel.
+        AsyncMinimumHeap* queue = &_queue;
+        std::shared_ptr<Waiter> waiter = _waiter;
+        _waiter->timer = _queue._executor.post_after ( _timeout, [queue, waiter] { queue->expire ( waiter ); } );
+    }
+    return true;
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+template <bool Timed>
+typename std::conditional<Timed, std::optional<Comparable>, Comparable>::type
+AsyncMinimumHeap<Comparable, Executor, Compare>::Awaiter<Timed>::await_resume ( )
+{
+    if ( _waiter )
+        _value = std::move ( _waiter->value );
+    if constexpr ( Timed )
+        return std::move ( _value );
+    else
+        return std::move ( *_value );
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+AsyncMinimumHeap<Comparable, Executor, Compare>::AsyncMinimumHeap ( Executor& executor, const Compare& compare )
+    : _heap ( 2, compare ), _executor { executor } {}
+
+template <typename Comparable, typename Executor, typename Compare>
+size_t AsyncMinimumHeap<Comparable, Executor, Compare>::size() const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _heap.size();
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+bool AsyncMinimumHeap<Comparable, Executor, Compare>::empty() const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _heap.empty();
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+size_t AsyncMinimumHeap<Comparable, Executor, Compare>::waiting() const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _waiters.size();
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+void AsyncMinimumHeap<Comparable, Executor, Compare>::insert ( Comparable element )
+{
+    std::vector<std::shared_ptr<Waiter>> woken;
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        _heap.insert ( std::move ( element ) );
+        deliver ( woken );
+    }
+    wake ( woken );
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+template <typename InputIterator>
+void AsyncMinimumHeap<Comparable, Executor, Compare>::insert_range ( InputIterator first, InputIterator last )
+{
+    std::vector<std::shared_ptr<Waiter>> woken;
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        _heap.insert_range ( first, last );
+        deliver ( woken );
+    }
+    wake ( woken );
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+std::optional<Comparable> AsyncMinimumHeap<Comparable, Executor, Compare>::try_pop ( )
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    if ( !_waiters.empty() || _heap.empty() )
+        return std::nullopt;
+    return _heap.pop();
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+typename AsyncMinimumHeap<Comparable, Executor, Compare>::template Awaiter<false>
+AsyncMinimumHeap<Comparable, Executor, Compare>::pop ( )
+{
+    return Awaiter<false> ( *this, std::chrono::nanoseconds::zero() );
+}
+
+template <typename Comparable, typename Executor, typename Compare>
+typename AsyncMinimumHeap<Comparable, Executor, Compare>::template Awaiter<true>
+AsyncMinimumHeap<Comparable, Executor, Compare>::pop_for ( std::chrono::nanoseconds timeout )
+{
+    return Awaiter<true> ( *this, timeout );
+}
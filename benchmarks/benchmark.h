@@ -0,0 +1,299 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Shared pieces of the benchmark programs: a comparison counting wrapper,
+ * hardware cache counters read through perf events, and a small writer for
+ * the JSON result files.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+
+/**
+ * Wraps a comparison function object and counts every call, so that a
+ * container built with it reports the comparisons it makes. The count is
+ * shared by every copy of the wrapper (and every container) on the thread.
+ */
+template <typename Compare>
+struct CountingCompare {
+
+    /** The number of comparisons made on this thread. **/
+    static thread_local uint64_t count;
+
+    Compare compare;
+
+    template <typename T>
+    bool operator() ( const T& lhs, const T& rhs ) const
+    {
+        count++;
+        return compare ( lhs, rhs );
+    }
+};
+
+template <typename Compare>
+thread_local uint64_t CountingCompare<Compare>::count = 0;
+
+/**
+ * Counts last-level cache misses, cache references, L1 data cache load
+ * misses, data TLB load misses and page faults of the calling thread (user
+ * space only) with Linux perf events. When
+ * perf events are unavailable (another OS, a container without access, or
+ * perf_event_paranoid set too high) available() is false and the counts are
+ * all zero.
+ */
+class PerfCounters {
+
+public:
+
+    /** The counted events. **/
+    enum Event { CacheMisses, CacheReferences, L1DLoadMisses, DTLBLoadMisses, PageFaults, Events };
+
+    /** The names of the counted events, as reported in the JSON results. **/
+    static const char* name ( Event event )
+    {
+        static const char* names[] = { "cache_misses", "cache_references", "l1d_load_misses",
+                                        "dtlb_load_misses", "page_faults" };
+        return names[event];
+    }
+
+private:
+
+    int _fds[Events];
+
+#if defined(__linux__)
+    static int open ( uint32_t type, uint64_t config )
+    {
+        perf_event_attr attr;
+        std::memset ( &attr, 0, sizeof attr );
+        attr.size = sizeof attr;
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int> ( syscall ( __NR_perf_event_open, &attr, 0, -1, -1, 0 ) );
+    }
+#endif
+
+public:
+
+    PerfCounters ( )
+    {
+        for ( int e = 0; e < Events; e++ )
+            _fds[e] = -1;
+#if defined(__linux__)
+        _fds[CacheMisses] = open ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES );
+        _fds[CacheReferences] = open ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES );
+        _fds[L1DLoadMisses] = open ( PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                                     | ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+                                     | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ) );
+        _fds[DTLBLoadMisses] = open ( PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+                                      | ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+                                      | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ) );
+        _fds[PageFaults] = open ( PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS );
+#endif
+    }
+
+    ~PerfCounters ( )
+    {
+#if defined(__linux__)
+        for ( int e = 0; e < Events; e++ )
+            if ( _fds[e] >= 0 )
+                close ( _fds[e] );
+#endif
+    }
+
+    PerfCounters ( const PerfCounters& rhs ) = delete;
+    PerfCounters& operator= ( const PerfCounters& rhs ) = delete;
+
+    /**
+     * Determines if the given event is being counted.
+     * @return true if the event could be opened, false otherwise.
+     */
+    bool available ( Event event ) const
+    {
+        return _fds[event] >= 0;
+    }
+
+    /**
+     * Resets all counts to zero and starts counting.
+     */
+    void start ( )
+    {
+#if defined(__linux__)
+        for ( int e = 0; e < Events; e++ )
+        {
+            if ( _fds[e] < 0 )
+                continue;
+            ioctl ( _fds[e], PERF_EVENT_IOC_RESET, 0 );
+            ioctl ( _fds[e], PERF_EVENT_IOC_ENABLE, 0 );
+        }
+#endif
+    }
+
+    /**
+     * Stops counting.
+     */
+    void stop ( )
+    {
+#if defined(__linux__)
+        for ( int e = 0; e < Events; e++ )
+            if ( _fds[e] >= 0 )
+                ioctl ( _fds[e], PERF_EVENT_IOC_DISABLE, 0 );
+#endif
+    }
+
+    /**
+     * Produces the count of the given event since the last start.
+     * @return the count, or 0 if the event is unavailable.
+     */
+    uint64_t read ( Event event ) const
+    {
+        uint64_t value = 0;
+#if defined(__linux__)
+        if ( _fds[event] >= 0 && ::read ( _fds[event], &value, sizeof value ) != sizeof value )
+            value = 0;
+#endif
+        return value;
+    }
+};
+
+/**
+ * Writes a benchmark result file: a JSON object with a description of the run
+ * and an array of results, one flat object per measurement.
+ */
+class BenchmarkJson {
+
+    std::ostream& _out;
+    bool _firstResult;
+    bool _firstField;
+
+public:
+
+    /**
+     * Starts the result file with the name of the benchmark, the compiler and
+     * the time of the run.
+     * @param out: the stream the file is written to.
+     * @param benchmark: the name of the benchmark program.
+     */
+    BenchmarkJson ( std::ostream& out, const std::string& benchmark )
+        : _out ( out ), _firstResult ( true ), _firstField ( true )
+    {
+        char date[32];
+        std::time_t now = std::time ( nullptr );
+        std::strftime ( date, sizeof date, "%Y-%m-%dT%H:%M:%SZ", std::gmtime ( &now ) );
+        _out << "{\n  \"benchmark\": " << quote ( benchmark )
+             << ",\n  \"date\": " << quote ( date )
+#if defined(__VERSION__)
+             << ",\n  \"compiler\": " << quote ( __VERSION__ )
+#endif
+#if defined(NDEBUG)
+             << ",\n  \"assertions\": false"
+#else
+             << ",\n  \"assertions\": true"
+#endif
+             << ",\n  \"results\": [";
+    }
+
+    /**
+     * Ends the result file.
+     */
+    ~BenchmarkJson ( )
+    {
+        _out << "\n  ]\n}\n";
+        _out.flush();
+    }
+
+    /**
+     * Quotes and escapes the given text as a JSON string.
+     */
+    static std::string quote ( const std::string& text )
+    {
+        std::string quoted = "\"";
+        for ( char c : text )
+        {
+            if ( c == '"' || c == '\\' )
+                quoted += '\\';
+            if ( static_cast<unsigned char> ( c ) < 0x20 )
+                quoted += ' ';
+            else
+                quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    /** Starts a new result object. **/
+    void begin ( )
+    {
+        _out << ( _firstResult ? "\n    {" : ",\n    {" );
+        _firstResult = false;
+        _firstField = true;
+    }
+
+    /** Ends the current result object. **/
+    void end ( )
+    {
+        _out << "}";
+    }
+
+    /** Adds a field to the current result object. **/
+    void field ( const char* key, const std::string& value )
+    {
+        separate ( key );
+        _out << quote ( value );
+    }
+
+    void field ( const char* key, const char* value )
+    {
+        field ( key, std::string ( value ) );
+    }
+
+    void field ( const char* key, uint64_t value )
+    {
+        separate ( key );
+        _out << value;
+    }
+
+    void field ( const char* key, double value )
+    {
+        separate ( key );
+        std::ostringstream number;
+        number.precision ( 6 );
+        number << value;
+        _out << number.str();
+    }
+
+    /** Adds a null field (a measurement that is not available). **/
+    void null ( const char* key )
+    {
+        separate ( key );
+        _out << "null";
+    }
+
+private:
+
+    void separate ( const char* key )
+    {
+        _out << ( _firstField ? "" : ", " ) << quote ( key ) << ": ";
+        _firstField = false;
+    }
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+#include "../blockedminimumheap.h"
+#include "benchmark.h"
+
+using namespace std;
+
+/** Keeps the popped keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+typedef MinimumHeapHugePageAllocator<uint64_t> HugePages;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/** Prints the count of the given event per operation, or n/a. **/
+void printPerOp ( const PerfCounters& perf, PerfCounters::Event event, double count )
+{
+    if ( perf.available( event ) )
+        cout << "\t" << count;
+    else
+        cout << "\tn/a";
+}
+
+/**
+ * Builds the heap from the keys, then runs the hold model on it (pop the
+ * smallest key and insert it again, increased by a random amount, keeping the
+ * size constant) for the given number of operations, three times, and prints
+ * the time, data TLB load misses and page faults per operation of the build
+ * and of the fastest hold run.
+ */
+template <typename Heap>
+void measure ( const char* name, const vector<uint64_t>& keys, size_t operations )
+{
+    PerfCounters perf;
+    mt19937_64 random ( 7 );
+
+    perf.start();
+    auto start = chrono::steady_clock::now();
+    Heap heap ( keys );
+    double built = since( start );
+    perf.stop();
+    cout << name << "\tbuild\t" << built * 1e9 / keys.size();
+    printPerOp( perf, PerfCounters::DTLBLoadMisses, (double) perf.read( PerfCounters::DTLBLoadMisses ) / keys.size() );
+    printPerOp( perf, PerfCounters::PageFaults, (double) perf.read( PerfCounters::PageFaults ) / keys.size() );
+    cout << endl;
+
+    double best = 0;
+    double misses = 0;
+    double faults = 0;
+    for ( int repeat=0; repeat<3; repeat++ )
+    {
+        perf.start();
+        start = chrono::steady_clock::now();
+        for ( size_t i=0; i<operations; i++ )
+        {
+            uint64_t key = heap.pop();
+            heap.insert( key + ( random() >> 24 ) );
+        }
+        double held = since( start );
+        perf.stop();
+        if ( repeat == 0 || held < best )
+        {
+            best = held;
+            misses = (double) perf.read( PerfCounters::DTLBLoadMisses ) / operations;
+            faults = (double) perf.read( PerfCounters::PageFaults ) / operations;
+        }
+    }
+    sink = heap.pop();
+    cout << name << "\thold\t" << best * 1e9 / operations;
+    printPerOp( perf, PerfCounters::DTLBLoadMisses, misses );
+    printPerOp( perf, PerfCounters::PageFaults, faults );
+    cout << endl;
+}
+
+/**
+ * Compares MinimumHeap's implicit binary layout with BlockedMinimumHeap's
+ * page-sized blocks, each with and without huge pages, on a heap of n random
+ * 8-byte keys: building it from a vector, then the hold model (a pop and an
+ * insert per operation). Prints ns, data TLB load misses and page faults per
+ * operation; the counters are n/a where perf events are unavailable (TLB
+ * misses are often not exposed to virtual machines).
+ *
+ * Usage: blocked_benchmark [n] [operations]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 1 << 25;
+    size_t operations = argc > 2 ? (size_t) strtod( argv[2], nullptr ) : 2000000;
+
+    mt19937_64 random ( 42 );
+    vector<uint64_t> keys ( n );
+    for ( size_t i=0; i<n; i++ )
+        keys[i] = random();
+
+    cout << "heap of " << n << " keys, " << operations << " hold operations" << endl
+         << "layout\t\t\tphase\tns/op\tdTLB misses/op\tpage faults/op" << endl;
+    measure<MinimumHeap<uint64_t>>( "implicit\t\t", keys, operations );
+    measure<MinimumHeap<uint64_t, 2, MinimumHeapPop::TopDown, less<uint64_t>, HugePages>>(
+        "implicit, huge pages\t", keys, operations );
+    measure<BlockedMinimumHeap<uint64_t>>( "blocked\t\t\t", keys, operations );
+    measure<BlockedMinimumHeap<uint64_t, 64>>( "blocked, 64-byte blocks", keys, operations );
+    measure<BlockedMinimumHeap<uint64_t, 4096, less<uint64_t>, HugePages>>(
+        "blocked, huge pages\t", keys, operations );
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+#include "../addressableminimumheap.h"
+#include "../tombstoneminimumheap.h"
+
+using namespace std;
+
+/** Keeps the results observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/** A job of a tenant, ordered by its deadline. **/
+struct Job {
+    uint64_t deadline;
+    uint32_t tenant;
+    bool operator< ( const Job& rhs ) const { return deadline < rhs.deadline; }
+};
+
+/**
+ * Cancels the jobs of every tenant below the given one from a heap of the
+ * given jobs: by filtering the elements into a vector and rebuilding the heap
+ * from it, and with erase_if. Prints the fastest of three runs of each, in ms.
+ */
+void bulk ( const vector<Job>& jobs, uint32_t tenants )
+{
+    double rebuild = 0;
+    double erase = 0;
+    for ( int repeat=0; repeat<3; repeat++ )
+    {
+        MinimumHeap<Job> heap ( jobs );
+        auto start = chrono::steady_clock::now();
+        vector<Job> kept;
+        for ( size_t i=0; i<heap.size(); i++ )
+            if ( heap[i].tenant >= tenants )
+                kept.push_back( heap[i] );
+        heap = MinimumHeap<Job> ( std::move( kept ) );
+        double seconds = since( start );
+        rebuild = repeat == 0 ? seconds : min( rebuild, seconds );
+        sink = heap.size();
+
+        heap = MinimumHeap<Job> ( jobs );
+        start = chrono::steady_clock::now();
+        heap.erase_if( [tenants] ( const Job& job ) { return job.tenant < tenants; } );
+        seconds = since( start );
+        erase = repeat == 0 ? seconds : min( erase, seconds );
+        sink = heap.size();
+    }
+    cout << tenants << "%\t\t" << rebuild * 1e3 << "\t\t" << erase * 1e3 << endl;
+}
+
+/**
+ * Cancels the given fraction of the jobs one at a time, in random order,
+ * while the rest are popped: with AddressableMinimumHeap::erase and with
+ * TombstoneMinimumHeap::mark_deleted. Prints the total time in ms and the
+ * longest single cancellation in us.
+ */
+void storm ( const vector<Job>& jobs, double fraction )
+{
+    mt19937_64 random ( 7 );
+    vector<size_t> order ( jobs.size() );
+    for ( size_t i=0; i<order.size(); i++ )
+        order[i] = i;
+    shuffle( order.begin(), order.end(), random );
+    order.resize( (size_t)( fraction * jobs.size() ) );
+
+    AddressableMinimumHeap<Job> addressable ( jobs.size() );
+    vector<AddressableMinimumHeap<Job>::Handle> addressed;
+    for ( const Job& job : jobs )
+        addressed.push_back( addressable.insert( job ) );
+    double worstErase = 0;
+    auto start = chrono::steady_clock::now();
+    for ( size_t i : order )
+    {
+        auto single = chrono::steady_clock::now();
+        if ( addressable.contains( addressed[i] ) )
+            addressable.erase( addressed[i] );
+        worstErase = max( worstErase, since( single ) );
+    }
+    double erased = since( start );
+
+    TombstoneMinimumHeap<Job> tombstones ( 0.5, jobs.size() );
+    vector<TombstoneMinimumHeap<Job>::Handle> handles;
+    for ( const Job& job : jobs )
+        handles.push_back( tombstones.insert( job ) );
+    double worstMark = 0;
+    start = chrono::steady_clock::now();
+    for ( size_t i : order )
+    {
+        auto single = chrono::steady_clock::now();
+        tombstones.mark_deleted( handles[i] );
+        worstMark = max( worstMark, since( single ) );
+    }
+    double marked = since( start );
+    sink = addressable.size() + tombstones.size();
+
+    cout << fraction * 100 << "%\t\t" << erased * 1e3 << "\t" << worstErase * 1e6 << "\t\t"
+         << marked * 1e3 << "\t" << worstMark * 1e6 << endl;
+}
+
+/**
+ * Compares the ways of cancelling queued jobs on a heap of n jobs of 100
+ * tenants: cancelling whole tenants at once (rebuilding the heap from a
+ * filtered vector against erase_if), and cancelling single jobs (eager
+ * AddressableMinimumHeap::erase against TombstoneMinimumHeap::mark_deleted,
+ * whose compactions show as its longest cancellation).
+ *
+ * Usage: erase_benchmark [n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 1000000;
+    mt19937_64 random ( 42 );
+    vector<Job> jobs ( n );
+    for ( Job& job : jobs )
+        job = Job { random(), (uint32_t)( random() % 100 ) };
+
+    cout << "heap of " << n << " jobs" << endl
+         << "cancelled\trebuild ms\terase_if ms" << endl;
+    for ( uint32_t tenants : { 1, 10, 50, 90 } )
+        bulk( jobs, tenants );
+
+    cout << "cancelled\terase ms\tworst us\tmark_deleted ms\tworst us" << endl;
+    for ( double fraction : { 0.1, 0.5, 0.9 } )
+        storm( jobs, fraction );
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../minimumheap.h"
+#include "../flatcombiningheap.h"
+
+using namespace std;
+
+/**
+ * A MinimumHeap guarded by a single global mutex, the baseline the
+ * FlatCombiningHeap is measured against.
+ */
+class LockedMinimumHeap
+{
+    mutex _mutex;
+    MinimumHeap<unsigned> _heap;
+public:
+    void insert ( unsigned element )
+    {
+        lock_guard<mutex> guard ( _mutex );
+        _heap.insert( element );
+    }
+    bool try_pop ( unsigned& element )
+    {
+        lock_guard<mutex> guard ( _mutex );
+        if ( _heap.empty() )
+            return false;
+        _heap.pop( element );
+        return true;
+    }
+};
+
+/**
+ * Runs the hold model on the given queue with the given number of threads:
+ * every thread repeatedly pops an element and inserts a slightly larger one.
+ * @return the throughput in millions of operations per second.
+ */
+template <typename Queue>
+double hold ( Queue& queue, size_t threads, size_t prefill, size_t operations )
+{
+    mt19937 random ( 42 );
+    for ( size_t i=0; i<prefill; i++ )
+        queue.insert( random() % 1000000 );
+
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for ( size_t t=0; t<threads; t++ )
+    {
+        workers.push_back( thread( [&queue, t, operations] ( )
+        {
+            mt19937 random ( (unsigned) t );
+            unsigned element;
+            for ( size_t i=0; i<operations; i+=2 )
+            {
+                if ( queue.try_pop( element ) )
+                    queue.insert( element + random() % 1000 );
+            }
+        } ) );
+    }
+    for ( size_t t=0; t<workers.size(); t++ )
+        workers[t].join();
+    double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+    return threads * operations / seconds / 1e6;
+}
+
+/**
+ * Measures the throughput of a FlatCombiningHeap against a mutex guarded
+ * MinimumHeap, both exact, for 1, 2, 4, ... up to the given number of
+ * threads (default = 64).
+ *
+ * Usage: flatcombining_benchmark [max threads] [operations per thread]
+ */
+int main ( int argc, char** argv )
+{
+    size_t maxThreads = argc > 1 ? strtoul( argv[1], nullptr, 10 ) : 64;
+    size_t operations = argc > 2 ? strtoul( argv[2], nullptr, 10 ) : 200000;
+    const size_t prefill = 1000000;
+
+    cout << "threads\tflat combining Mops/s\tlocked heap Mops/s" << endl;
+    for ( size_t threads=1; ; threads = min( threads * 2, maxThreads ) )
+    {
+        FlatCombiningHeap<unsigned> combining ( threads );
+        LockedMinimumHeap locked;
+        double combiningRate = hold( combining, threads, prefill, operations );
+        double lockedRate = hold( locked, threads, prefill, operations );
+        cout << threads << "\t" << combiningRate << "\t\t\t" << lockedRate << endl;
+        if ( threads == maxThreads )
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../minimumheap.h"
+#include "../kwaymerge.h"
+#include "benchmark.h"
+
+using namespace std;
+
+/** Keeps the merged keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** A key and the index of the run it came from. **/
+typedef pair<uint64_t, size_t> Tagged;
+
+/** Orders tagged keys by key only, as a merge needs. **/
+struct KeyLess {
+    bool operator() ( const Tagged& lhs, const Tagged& rhs ) const { return lhs.first < rhs.first; }
+};
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Merges the runs with a MinimumHeap of (key, run) pairs, popping the
+ * smallest pair and inserting the next key of its run.
+ */
+template <typename Less>
+void heapPopInsert ( const vector<vector<uint64_t>>& runs, vector<uint64_t>& out )
+{
+    MinimumHeap<Tagged, 2, MinimumHeapPop::TopDown, Less> heap ( runs.size() );
+    vector<size_t> next ( runs.size(), 1 );
+    for ( size_t r=0; r<runs.size(); r++ )
+        heap.insert( Tagged ( runs[r][0], r ) );
+    while ( !heap.empty() )
+    {
+        Tagged top = heap.pop();
+        out.push_back( top.first );
+        if ( next[top.second] < runs[top.second].size() )
+            heap.insert( Tagged ( runs[top.second][next[top.second]++], top.second ) );
+    }
+}
+
+/**
+ * Merges the runs with a MinimumHeap of (key, run) pairs, replacing the
+ * smallest pair by the next key of its run in a single sift down.
+ */
+template <typename Less>
+void heapReplaceTop ( const vector<vector<uint64_t>>& runs, vector<uint64_t>& out )
+{
+    MinimumHeap<Tagged, 2, MinimumHeapPop::TopDown, Less> heap ( runs.size() );
+    vector<size_t> next ( runs.size(), 1 );
+    for ( size_t r=0; r<runs.size(); r++ )
+        heap.insert( Tagged ( runs[r][0], r ) );
+    while ( !heap.empty() )
+    {
+        size_t r = heap.top().second;
+        out.push_back( heap.top().first );
+        if ( next[r] < runs[r].size() )
+            heap.replace_top( Tagged ( runs[r][next[r]++], r ) );
+        else
+            heap.pop();
+    }
+}
+
+/** Merges the runs with a KWayMerge. **/
+template <typename Less>
+void loserTree ( const vector<vector<uint64_t>>& runs, vector<uint64_t>& out )
+{
+    KWayMerge<uint64_t, Less> merge;
+    for ( size_t r=0; r<runs.size(); r++ )
+        merge.add( runs[r].begin(), runs[r].end() );
+    merge.drain( back_inserter( out ) );
+}
+
+/**
+ * Times the given merge of the runs (the best of three merges).
+ * @return the average time per merged key in nanoseconds.
+ */
+template <typename Merge>
+double time ( const vector<vector<uint64_t>>& runs, size_t n, Merge merge )
+{
+    double best = 0;
+    for ( int repeat=0; repeat<3; repeat++ )
+    {
+        vector<uint64_t> out;
+        out.reserve( n );
+        auto start = chrono::steady_clock::now();
+        merge( runs, out );
+        double seconds = since( start );
+        sink = out.back();
+        best = repeat == 0 ? seconds : min( best, seconds );
+    }
+    return best * 1e9 / n;
+}
+
+/**
+ * Counts the comparisons made by the given merge of the runs, which must
+ * compare with a CountingCompare<Compare>.
+ * @return the average number of comparisons per merged key.
+ */
+template <typename Compare, typename Merge>
+double comparisons ( const vector<vector<uint64_t>>& runs, size_t n, Merge merge )
+{
+    vector<uint64_t> out;
+    out.reserve( n );
+    CountingCompare<Compare>::count = 0;
+    merge( runs, out );
+    return (double) CountingCompare<Compare>::count / n;
+}
+
+/**
+ * Compares merging k sorted runs of random keys (n keys in all) with a
+ * MinimumHeap of (key, run) pairs, by pop and insert and by replace_top, and
+ * with a KWayMerge (loser tree), for k = 2, 4, ... 4096: the time per key,
+ * then the comparisons per key.
+ *
+ * Usage: kway_benchmark [n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 10000000;
+    mt19937_64 random ( 42 );
+
+    cout << "merge of k runs, " << n << " keys (ns per key | comparisons per key)" << endl
+         << "k\tpop and insert\treplace_top\tKWayMerge\t| pop and insert\treplace_top\tKWayMerge" << endl;
+    for ( size_t k=2; k<=4096; k*=2 )
+    {
+        vector<vector<uint64_t>> runs ( k, vector<uint64_t> ( max<size_t>( 1, n / k ) ) );
+        for ( vector<uint64_t>& run : runs )
+        {
+            for ( uint64_t& key : run )
+                key = random();
+            sort( run.begin(), run.end() );
+        }
+        size_t total = runs.size() * runs[0].size();
+        cout << k << "\t" << time( runs, total, heapPopInsert<KeyLess> ) << "\t\t"
+             << time( runs, total, heapReplaceTop<KeyLess> ) << "\t\t"
+             << time( runs, total, loserTree<std::less<uint64_t>> ) << "\t\t| "
+             << comparisons<KeyLess>( runs, total, heapPopInsert<CountingCompare<KeyLess>> ) << "\t\t"
+             << comparisons<KeyLess>( runs, total, heapReplaceTop<CountingCompare<KeyLess>> ) << "\t\t"
+             << comparisons<std::less<uint64_t>>( runs, total, loserTree<CountingCompare<std::less<uint64_t>>> )
+             << endl;
+    }
+    return 0;
+}
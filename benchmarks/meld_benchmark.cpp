@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+#include "../pairingheap.h"
+
+using namespace std;
+
+/** Keeps the popped keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces n random keys. **/
+vector<uint64_t> keys ( size_t n, mt19937_64& random )
+{
+    vector<uint64_t> result ( n );
+    for ( size_t i=0; i<n; i++ )
+        result[i] = random() >> 16;
+    return result;
+}
+
+/** Produces a heap of the given type holding the given keys. **/
+template <typename Heap>
+Heap build ( const vector<uint64_t>& values )
+{
+    Heap heap;
+    for ( size_t i=0; i<values.size(); i++ )
+        heap.insert( values[i] );
+    return heap;
+}
+
+/**
+ * Merges a heap of m keys into one of n keys, the way the given merge
+ * function does, repeated (building the heaps again each time) for about
+ * 0.3 s in all.
+ * @return the average time of one merge in microseconds.
+ */
+template <typename Heap, typename Merge>
+double merge ( size_t n, size_t m, Merge how )
+{
+    mt19937_64 random ( 42 );
+    vector<uint64_t> large = keys( n, random );
+    vector<uint64_t> small = keys( m, random );
+    double seconds = 0;
+    size_t merges = 0;
+    auto begin = chrono::steady_clock::now();
+    while ( merges < 3 || chrono::steady_clock::now() - begin < chrono::milliseconds( 300 ) )
+    {
+        Heap into = build<Heap>( large );
+        Heap from = build<Heap>( small );
+        auto start = chrono::steady_clock::now();
+        how( into, from );
+        seconds += chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+        sink = into.top();
+        merges++;
+    }
+    return seconds * 1e6 / merges;
+}
+
+/**
+ * Runs the hold model on a heap of n keys: pop the smallest key and insert a
+ * slightly larger one.
+ * @return the average time of one pop and insert pair in nanoseconds.
+ */
+template <typename Heap>
+double hold ( size_t n )
+{
+    const size_t operations = 2000000;
+    mt19937_64 random ( 42 );
+    Heap heap = build<Heap>( keys( n, random ) );
+    auto start = chrono::steady_clock::now();
+    for ( size_t i=0; i<operations; i++ )
+        heap.insert( heap.pop() + ( random() & 0xFFFF ) );
+    double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+    sink = heap.top();
+    return seconds * 1e9 / operations;
+}
+
+/**
+ * Compares merging two MinimumHeaps (MinimumHeap::merge, and popping every key
+ * of one heap into the other) with merging two PairingHeaps, for heaps of
+ * equal size and for a small heap merged into a large one, then compares the
+ * cost of pop and insert between merges with the hold model.
+ *
+ * Usage: meld_benchmark [max n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t maximum = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 1000000;
+
+    auto merged = [] ( auto& into, auto& from ) { into.merge( std::move( from ) ); };
+    auto reinserted = [] ( auto& into, auto& from )
+    {
+        while ( !from.empty() )
+            into.insert( from.pop() );
+    };
+
+    cout << "merge of m keys into n keys (us per merge)" << endl
+         << "n\tm\tMinimumHeap::merge\tpop and insert\tPairingHeap::merge" << endl;
+    for ( size_t n=1000; n<=maximum; n*=10 )
+    {
+        for ( size_t m : { n, n / 100 } )
+        {
+            cout << n << "\t" << m << "\t"
+                 << merge<MinimumHeap<uint64_t>>( n, m, merged ) << "\t\t\t"
+                 << merge<MinimumHeap<uint64_t>>( n, m, reinserted ) << "\t\t"
+                 << merge<PairingHeap<uint64_t>>( n, m, merged ) << endl;
+        }
+    }
+
+    cout << endl << "hold model (ns per pop and insert)" << endl
+         << "n\tMinimumHeap\tPairingHeap" << endl;
+    for ( size_t n=1000; n<=maximum; n*=10 )
+        cout << n << "\t" << hold<MinimumHeap<uint64_t>>( n ) << "\t\t"
+             << hold<PairingHeap<uint64_t>>( n ) << endl;
+    return 0;
+}
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include "../minimumheap.h"
+#include "benchmark.h"
+
+using namespace std;
+
+/** Keeps the popped keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+uint64_t observe ( int64_t key ) { return static_cast<uint64_t> ( key ); }
+uint64_t observe ( const string& key ) { return key.size() + static_cast<unsigned char> ( key[key.size() - 1] ); }
+
+/**
+ * Reverses a comparison, so that std::priority_queue (a maximum heap) keeps
+ * the smallest element on top.
+ */
+template <typename Compare>
+struct Reversed {
+    Compare compare;
+
+    template <typename T>
+    bool operator() ( const T& lhs, const T& rhs ) const
+    {
+        return compare ( rhs, lhs );
+    }
+};
+
+/**
+ * The baseline: std::priority_queue ordered by the reversed comparison.
+ */
+template <typename Key, typename Compare>
+struct StdPriorityQueue {
+    typedef priority_queue<Key, vector<Key>, Reversed<Compare>> Queue;
+
+    static Queue make ( ) { return Queue(); }
+    static Queue make ( vector<Key>&& keys ) { return Queue ( Reversed<Compare>(), std::move ( keys ) ); }
+    static void insert ( Queue& queue, Key&& key ) { queue.push ( std::move ( key ) ); }
+    static Key pop ( Queue& queue )
+    {
+        // The top is moved out rather than copied, as MinimumHeap::pop does;
+        // pop() overwrites it without comparing it.
+        Key key = std::move ( const_cast<Key&> ( queue.top() ) );
+        queue.pop();
+        return key;
+    }
+};
+
+/**
+ * A MinimumHeap of the given arity and pop strategy.
+ */
+template <typename Key, typename Compare, size_t Arity, MinimumHeapPop Pop>
+struct Heap {
+    typedef MinimumHeap<Key, Arity, Pop, Compare> Queue;
+
+    static Queue make ( ) { return Queue(); }
+    static Queue make ( vector<Key>&& keys ) { return Queue ( std::move ( keys ) ); }
+    static void insert ( Queue& queue, Key&& key ) { queue.insert ( std::move ( key ) ); }
+    static Key pop ( Queue& queue ) { return queue.pop(); }
+};
+
+/**
+ * Accumulates the time, operations and perf event counts of the timed parts
+ * of repeated runs of a workload.
+ */
+class Meter {
+
+    PerfCounters& _perf;
+    chrono::steady_clock::time_point _start;
+
+public:
+
+    double seconds = 0;
+    uint64_t operations = 0;
+    uint64_t events[PerfCounters::Events] = {};
+
+    explicit Meter ( PerfCounters& perf ) : _perf ( perf ) { }
+
+    void begin ( )
+    {
+        _perf.start();
+        _start = chrono::steady_clock::now();
+    }
+
+    void end ( uint64_t ops )
+    {
+        seconds += chrono::duration<double> ( chrono::steady_clock::now() - _start ).count();
+        _perf.stop();
+        for ( int e = 0; e < PerfCounters::Events; e++ )
+            events[e] += _perf.read ( PerfCounters::Event ( e ) );
+        operations += ops;
+    }
+};
+
+/** Insert: n keys are inserted into an empty queue. **/
+template <typename Q, typename Key>
+struct Insert {
+    static void run ( const vector<Key>& keys, Meter& meter )
+    {
+        vector<Key> copy = keys;
+        typename Q::Queue queue = Q::make();
+        meter.begin();
+        for ( size_t i=0; i<copy.size(); i++ )
+            Q::insert ( queue, std::move ( copy[i] ) );
+        meter.end ( copy.size() );
+    }
+};
+
+/** Pop: all n keys are popped from a queue built from them. **/
+template <typename Q, typename Key>
+struct Pop {
+    static void run ( const vector<Key>& keys, Meter& meter )
+    {
+        typename Q::Queue queue = Q::make ( vector<Key> ( keys ) );
+        uint64_t seen = 0;
+        meter.begin();
+        for ( size_t i=0; i<keys.size(); i++ )
+            seen += observe ( Q::pop ( queue ) );
+        meter.end ( keys.size() );
+        sink = seen;
+    }
+};
+
+/** Heapify: a queue is built from a vector of n keys in one step. **/
+template <typename Q, typename Key>
+struct Heapify {
+    static void run ( const vector<Key>& keys, Meter& meter )
+    {
+        vector<Key> copy = keys;
+        meter.begin();
+        typename Q::Queue queue = Q::make ( std::move ( copy ) );
+        meter.end ( keys.size() );
+        sink = observe ( Q::pop ( queue ) );
+    }
+};
+
+/**
+ * Hold: a queue of n keys repeatedly pops its smallest key and inserts it
+ * again advanced by a random increment, as an event simulation does. One
+ * operation is one pop and insert pair.
+ */
+template <typename Q, typename Key>
+struct Hold {
+    static void run ( const vector<Key>& keys, Meter& meter )
+    {
+        const size_t operations = 1000000;
+        mt19937_64 random ( 7 );
+        vector<Key> increments ( operations );
+        for ( size_t i=0; i<operations; i++ )
+            increments[i] = static_cast<Key> ( random() % 1000000 );
+
+        typename Q::Queue queue = Q::make ( vector<Key> ( keys ) );
+        meter.begin();
+        for ( size_t i=0; i<operations; i++ )
+            Q::insert ( queue, Q::pop ( queue ) + increments[i] );
+        meter.end ( operations );
+    }
+};
+
+/**
+ * Payload: n heavy (heap-allocated) std::string keys are inserted into an
+ * empty queue and then all popped. One operation is one insert or one pop.
+ */
+template <typename Q, typename Key>
+struct Payload {
+    static void run ( const vector<Key>& keys, Meter& meter )
+    {
+        vector<Key> copy = keys;
+        typename Q::Queue queue = Q::make();
+        uint64_t seen = 0;
+        meter.begin();
+        for ( size_t i=0; i<copy.size(); i++ )
+            Q::insert ( queue, std::move ( copy[i] ) );
+        for ( size_t i=0; i<copy.size(); i++ )
+            seen += observe ( Q::pop ( queue ) );
+        meter.end ( 2 * copy.size() );
+        sink = seen;
+    }
+};
+
+/**
+ * Produces n integer keys drawn from the named distribution.
+ */
+vector<int64_t> generate ( const string& distribution, size_t n )
+{
+    mt19937_64 random ( 42 );
+    vector<int64_t> keys ( n );
+    for ( size_t i=0; i<n; i++ )
+    {
+        if ( distribution == "uniform" )
+            keys[i] = static_cast<int64_t> ( random() >> 24 );
+        else if ( distribution == "ascending" )
+            keys[i] = static_cast<int64_t> ( i );
+        else if ( distribution == "descending" )
+            keys[i] = static_cast<int64_t> ( n - i );
+        else // few_unique
+            keys[i] = static_cast<int64_t> ( random() % 16 );
+    }
+    return keys;
+}
+
+/**
+ * Produces the string keys for the given integer keys: 40 characters, too long
+ * for the small string buffer, ordered as the integers are.
+ */
+vector<string> strings ( const vector<int64_t>& keys )
+{
+    vector<string> text ( keys.size() );
+    char buffer[48];
+    for ( size_t i=0; i<keys.size(); i++ )
+    {
+        snprintf ( buffer, sizeof buffer, "payload-%020lld-%011zu", (long long) keys[i], i % 100000000000 );
+        text[i] = buffer;
+    }
+    return text;
+}
+
+/**
+ * Measures one container on one workload: the timed runs are repeated until
+ * at least a million operations have been done, then the workload is run once
+ * more with a counting comparison to count the comparisons per operation.
+ */
+template <typename Key>
+void measure ( BenchmarkJson& json, PerfCounters& perf, const char* workload,
+               void (*timed) ( const vector<Key>&, Meter& ),
+               void (*counted) ( const vector<Key>&, Meter& ),
+               const char* container, const string& distribution, const vector<Key>& keys )
+{
+    Meter meter ( perf );
+    do
+        timed ( keys, meter );
+    while ( meter.operations < 1000000 );
+
+    PerfCounters none;
+    Meter counting ( none );
+    CountingCompare<less<Key>>::count = 0;
+    counted ( keys, counting );
+    double comparisons = double ( CountingCompare<less<Key>>::count ) / counting.operations;
+
+    json.begin();
+    json.field ( "workload", workload );
+    json.field ( "container", container );
+    json.field ( "distribution", distribution );
+    json.field ( "n", uint64_t ( keys.size() ) );
+    json.field ( "operations", meter.operations );
+    json.field ( "ns_per_op", meter.seconds * 1e9 / meter.operations );
+    json.field ( "comparisons_per_op", comparisons );
+    for ( int e = 0; e < PerfCounters::Events; e++ )
+    {
+        string key = string ( PerfCounters::name ( PerfCounters::Event ( e ) ) ) + "_per_op";
+        if ( perf.available ( PerfCounters::Event ( e ) ) )
+            json.field ( key.c_str(), double ( meter.events[e] ) / meter.operations );
+        else
+            json.null ( key.c_str() );
+    }
+    json.end();
+
+    cerr << workload << "\t" << container << "\t" << distribution << "\t" << keys.size()
+         << "\t" << meter.seconds * 1e9 / meter.operations << " ns/op\t"
+         << comparisons << " cmp/op" << endl;
+}
+
+/**
+ * Measures a workload, for keys of the given type, on std::priority_queue and
+ * on binary, 4-ary and bottom-up MinimumHeaps.
+ */
+template <typename Key, template <typename, typename> class Workload>
+void suite ( BenchmarkJson& json, PerfCounters& perf, const char* name,
+             const string& distribution, const vector<Key>& keys )
+{
+    typedef less<Key> Plain;
+    typedef CountingCompare<less<Key>> Counting;
+    const MinimumHeapPop TopDown = MinimumHeapPop::TopDown;
+    const MinimumHeapPop BottomUp = MinimumHeapPop::BottomUp;
+
+    measure<Key> ( json, perf, name,
+                   Workload<StdPriorityQueue<Key, Plain>, Key>::run,
+                   Workload<StdPriorityQueue<Key, Counting>, Key>::run,
+                   "std::priority_queue", distribution, keys );
+    measure<Key> ( json, perf, name,
+                   Workload<Heap<Key, Plain, 2, TopDown>, Key>::run,
+                   Workload<Heap<Key, Counting, 2, TopDown>, Key>::run,
+                   "MinimumHeap<2>", distribution, keys );
+    measure<Key> ( json, perf, name,
+                   Workload<Heap<Key, Plain, 4, TopDown>, Key>::run,
+                   Workload<Heap<Key, Counting, 4, TopDown>, Key>::run,
+                   "MinimumHeap<4>", distribution, keys );
+    measure<Key> ( json, perf, name,
+                   Workload<Heap<Key, Plain, 2, BottomUp>, Key>::run,
+                   Workload<Heap<Key, Counting, 2, BottomUp>, Key>::run,
+                   "MinimumHeap<2, BottomUp>", distribution, keys );
+}
+
+/**
+ * Measures MinimumHeap against std::priority_queue on the insert, pop, hold,
+ * heapify and payload (std::string) workloads, for 1e3, 1e4, ... elements up
+ * to the given maximum (default = 1e6, up to 1e8 fits in 16 GB) and for
+ * uniform, ascending, descending and few-unique keys. Results are written as
+ * JSON to the given file (default = standard output); progress goes to
+ * standard error.
+ *
+ * Usage: minimumheap_benchmark [--min n] [--max n] [--workload name] [--out file]
+ */
+int main ( int argc, char** argv )
+{
+    size_t minimum = 1000;
+    size_t maximum = 1000000;
+    string only;
+    string output;
+    for ( int i=1; i+1<argc; i+=2 )
+    {
+        if ( strcmp( argv[i], "--min" ) == 0 )
+            minimum = (size_t) strtod( argv[i+1], nullptr );
+        else if ( strcmp( argv[i], "--max" ) == 0 )
+            maximum = (size_t) strtod( argv[i+1], nullptr );
+        else if ( strcmp( argv[i], "--workload" ) == 0 )
+            only = argv[i+1];
+        else if ( strcmp( argv[i], "--out" ) == 0 )
+            output = argv[i+1];
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--min n] [--max n] [--workload name] [--out file]" << endl;
+            return 1;
+        }
+    }
+
+    ofstream file;
+    if ( !output.empty() )
+    {
+        file.open( output );
+        if ( !file )
+        {
+            cerr << "Cannot write " << output << endl;
+            return 1;
+        }
+    }
+
+    PerfCounters perf;
+    if ( !perf.available( PerfCounters::CacheMisses ) )
+        cerr << "perf events unavailable: cache counters will be null" << endl;
+
+    BenchmarkJson json ( output.empty() ? cout : file, "minimumheap_benchmark" );
+    const char* distributions[] = { "uniform", "ascending", "descending", "few_unique" };
+    for ( size_t n=max<size_t>( minimum, 1 ); n<=maximum; n*=10 )
+    {
+        for ( const char* distribution : distributions )
+        {
+            vector<int64_t> keys = generate( distribution, n );
+            if ( only.empty() || only == "insert" )
+                suite<int64_t, Insert>( json, perf, "insert", distribution, keys );
+            if ( only.empty() || only == "pop" )
+                suite<int64_t, Pop>( json, perf, "pop", distribution, keys );
+            if ( only.empty() || only == "hold" )
+                suite<int64_t, Hold>( json, perf, "hold", distribution, keys );
+            if ( only.empty() || only == "heapify" )
+                suite<int64_t, Heapify>( json, perf, "heapify", distribution, keys );
+            if ( only.empty() || only == "payload" )
+            {
+                vector<string> text = strings( keys );
+                keys = vector<int64_t>();
+                suite<string, Payload>( json, perf, "payload", distribution, text );
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../minimumheap.h"
+
+using namespace std;
+
+/** Keeps the results observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Measures building a MinimumHeap from a vector of n random keys, and
+ * draining it sorted, sequentially and then in parallel on 1, 2, 4, ... up to
+ * twice the number of hardware threads, and reports the speedup of each over
+ * the sequential algorithm. The vector is copied before each timed build.
+ *
+ * Usage: parallel_benchmark [n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 100000000;
+    size_t hardware = max<size_t>( 1, thread::hardware_concurrency() );
+
+    mt19937_64 random ( 42 );
+    vector<uint64_t> keys ( n );
+    for ( size_t i=0; i<n; i++ )
+        keys[i] = random();
+
+    vector<uint64_t> copy = keys;
+    auto start = chrono::steady_clock::now();
+    MinimumHeap<uint64_t> heap ( std::move( copy ) );
+    double build = since( start );
+    start = chrono::steady_clock::now();
+    sink = heap.sorted_drain().back();
+    double drain = since( start );
+
+    cout << "n = " << n << ", " << hardware << " hardware threads" << endl
+         << "threads\tbuild (s)\tspeedup\tsorted_drain (s)\tspeedup" << endl
+         << "seq\t" << build << "\t1\t" << drain << "\t\t1" << endl;
+    for ( size_t threads=1; threads<=2*hardware; threads*=2 )
+    {
+        copy = keys;
+        start = chrono::steady_clock::now();
+        MinimumHeap<uint64_t> parallel ( MinimumHeapParallel { threads }, std::move( copy ) );
+        double built = since( start );
+        start = chrono::steady_clock::now();
+        sink = parallel.sorted_drain( MinimumHeapParallel { threads } ).back();
+        double drained = since( start );
+        cout << threads << "\t" << built << "\t" << build / built << "\t"
+             << drained << "\t\t" << drain / drained << endl;
+    }
+    return 0;
+}
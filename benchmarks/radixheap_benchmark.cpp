@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "../minimumheap.h"
+#include "../radixheap.h"
+
+using namespace std;
+
+/** Keeps the popped times observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/**
+ * Runs a discrete-event simulation on the given queue of event times: the
+ * queue starts with the given number of pending events, then the next event
+ * is repeatedly popped and a new one scheduled a random delay after it (the
+ * hold model). The delays are exponentially distributed, as for the arrivals
+ * of a queueing network.
+ * @return the average time of one pop and insert pair in nanoseconds.
+ */
+template <typename Queue>
+double simulate ( size_t pending, size_t events )
+{
+    mt19937_64 random ( 42 );
+    exponential_distribution<double> delay ( 1.0 / 1000000 );
+    Queue queue;
+    for ( size_t i=0; i<pending; i++ )
+        queue.insert( (uint64_t) delay( random ) );
+
+    uint64_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for ( size_t i=0; i<events; i++ )
+    {
+        uint64_t now = queue.pop();
+        checksum += now;
+        queue.insert( now + (uint64_t) delay( random ) );
+    }
+    double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+    sink = checksum;
+    return seconds * 1e9 / events;
+}
+
+/**
+ * Measures the time per event of a RadixHeap against binary and 4-ary
+ * MinimumHeaps for 1e3 to 1e6 pending events.
+ *
+ * Usage: radixheap_benchmark [events]
+ */
+int main ( int argc, char** argv )
+{
+    size_t events = argc > 1 ? strtoul( argv[1], nullptr, 10 ) : 10000000;
+
+    cout << "pending\tradix ns/event\tbinary ns/event\t4-ary ns/event" << endl;
+    for ( size_t pending=1000; pending<=1000000; pending*=10 )
+    {
+        double radix = simulate<RadixHeap<uint64_t>>( pending, events );
+        double binary = simulate<MinimumHeap<uint64_t>>( pending, events );
+        double quaternary = simulate<MinimumHeap<uint64_t, 4>>( pending, events );
+        cout << pending << "\t" << radix << "\t\t" << binary << "\t\t" << quaternary << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+#include "../mappedminimumheap.h"
+
+using namespace std;
+
+/** Keeps the popped keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Compares the ways of restarting with a heap of n keys: rebuilding it by
+ * inserting every key again, loading a snapshot with MinimumHeap::load, and
+ * mapping the snapshot with MappedMinimumHeap (with and without verifying the
+ * checksum), each up to the first pop. The file is read from the page cache,
+ * so the times are those of a warm restart.
+ *
+ * Usage: snapshot_benchmark [n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 10000000;
+    string path = ( filesystem::temp_directory_path() / "snapshot_benchmark.snapshot" ).string();
+
+    mt19937_64 random ( 42 );
+    vector<uint64_t> keys ( n );
+    for ( size_t i=0; i<n; i++ )
+        keys[i] = random();
+
+    auto start = chrono::steady_clock::now();
+    MinimumHeap<uint64_t> heap;
+    for ( size_t i=0; i<n; i++ )
+        heap.insert( keys[i] );
+    sink = heap.pop();
+    double rebuilt = since( start );
+    {
+        ofstream file ( path, ios::binary );
+        heap.save( file );
+    }
+
+    start = chrono::steady_clock::now();
+    {
+        ifstream file ( path, ios::binary );
+        MinimumHeap<uint64_t> loaded = MinimumHeap<uint64_t>::load( file );
+        sink = loaded.pop();
+    }
+    double loaded = since( start );
+
+    start = chrono::steady_clock::now();
+    {
+        MappedMinimumHeap<uint64_t> mapped ( path );
+        sink = mapped.pop();
+    }
+    double verified = since( start );
+
+    start = chrono::steady_clock::now();
+    {
+        MappedMinimumHeap<uint64_t> mapped ( path, false );
+        sink = mapped.pop();
+    }
+    double mapped = since( start );
+    remove( path.c_str() );
+
+    cout << "restart with " << n << " keys up to the first pop (ms)" << endl
+         << "insert\tload\tmap (verified)\tmap" << endl
+         << rebuilt * 1e3 << "\t" << loaded * 1e3 << "\t" << verified * 1e3 << "\t\t"
+         << mapped * 1e3 << endl;
+    return 0;
+}
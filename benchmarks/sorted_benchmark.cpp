@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+
+using namespace std;
+
+/** Keeps the results observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Runs the given report of the k smallest keys three times.
+ * @return the fastest time in microseconds.
+ */
+template <typename Report>
+double best ( Report report )
+{
+    double fastest = 0;
+    for ( int repeat=0; repeat<3; repeat++ )
+    {
+        auto start = chrono::steady_clock::now();
+        sink = report();
+        double seconds = since( start );
+        fastest = repeat == 0 ? seconds : min( fastest, seconds );
+    }
+    return fastest * 1e6;
+}
+
+/**
+ * Compares the ways of reporting the k smallest keys of a heap of n keys
+ * without changing it: copying the heap and popping k keys, copying and
+ * sorting its keys, and iterating over the first k of sorted().
+ *
+ * Usage: sorted_benchmark [n]
+ */
+int main ( int argc, char** argv )
+{
+    size_t n = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 1000000;
+    mt19937_64 random ( 42 );
+    vector<uint64_t> keys ( n );
+    for ( uint64_t& key : keys )
+        key = random();
+    const MinimumHeap<uint64_t> heap ( keys );
+
+    cout << "heap of " << n << " keys, report the k smallest (us)" << endl
+         << "k\tcopy, pop\tcopy, sort\tsorted()" << endl;
+    for ( size_t k : { 10, 100, 1000, 10000 } )
+    {
+        double popped = best( [&heap, k] {
+            MinimumHeap<uint64_t> copy = heap;
+            uint64_t sum = 0;
+            for ( size_t i=0; i<k; i++ )
+                sum += copy.pop();
+            return sum;
+        } );
+        double sorted = best( [&heap, k] {
+            vector<uint64_t> copy;
+            copy.reserve( heap.size() );
+            for ( size_t i=0; i<heap.size(); i++ )
+                copy.push_back( heap[i] );
+            partial_sort( copy.begin(), copy.begin() + k, copy.end() );
+            uint64_t sum = 0;
+            for ( size_t i=0; i<k; i++ )
+                sum += copy[i];
+            return sum;
+        } );
+        double lazy = best( [&heap, k] {
+            uint64_t sum = 0;
+            auto it = heap.sorted().begin();
+            for ( size_t i=0; i<k; i++, ++it )
+                sum += *it;
+            return sum;
+        } );
+        cout << k << "\t" << popped << "\t\t" << sorted << "\t\t" << lazy << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../minimumheap.h"
+#include "../staticminimumheap.h"
+
+using namespace std;
+
+/** Keeps the popped keys observable so the loops are not optimised away. **/
+volatile uint64_t sink;
+
+/** Produces the seconds elapsed since the given time. **/
+double since ( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Runs the life of a short-lived queue of N keys the given number of times:
+ * create the heap, insert N keys, pop them all.
+ * @return the average time per queue in nanoseconds.
+ */
+template <size_t N, typename Create>
+double queues ( const vector<uint64_t>& keys, size_t times, Create create )
+{
+    double best = 0;
+    for ( int repeat=0; repeat<3; repeat++ )
+    {
+        auto start = chrono::steady_clock::now();
+        for ( size_t t=0; t<times; t++ )
+        {
+            auto heap = create();
+            const uint64_t* key = keys.data() + ( t % ( keys.size() / N ) ) * N;
+            for ( size_t i=0; i<N; i++ )
+                heap.insert( key[i] );
+            uint64_t sum = 0;
+            while ( !heap.empty() )
+                sum += heap.pop();
+            sink = sum;
+        }
+        double seconds = since( start );
+        best = repeat == 0 ? seconds : min( best, seconds );
+    }
+    return best * 1e9 / times;
+}
+
+/** Prints the time per queue of N keys of each heap. **/
+template <size_t N>
+void compare ( const vector<uint64_t>& keys, size_t times )
+{
+    cout << N << "\t"
+         << queues<N>( keys, times, [] { return MinimumHeap<uint64_t>(); } ) << "\t\t"
+         << queues<N>( keys, times, [] { return MinimumHeap<uint64_t> ( N ); } ) << "\t\t"
+         << queues<N>( keys, times, [] { return StaticMinimumHeap<uint64_t, N>(); } ) << endl;
+}
+
+/**
+ * Compares the queues of a few keys a server keeps per connection held in a
+ * MinimumHeap (starting from the default capacity, and with the capacity
+ * given up front) and in a StaticMinimumHeap, which never allocates: the time
+ * to create a queue, insert N keys and pop them, for N = 8 to 64.
+ *
+ * Usage: static_benchmark [queues]
+ */
+int main ( int argc, char** argv )
+{
+    size_t times = argc > 1 ? (size_t) strtod( argv[1], nullptr ) : 200000;
+    mt19937_64 random ( 42 );
+    vector<uint64_t> keys ( 1 << 16 );
+    for ( uint64_t& key : keys )
+        key = random();
+
+    cout << "create, insert N keys, pop them (ns per queue)" << endl
+         << "N\tMinimumHeap\tMinimumHeap(N)\tStaticMinimumHeap" << endl;
+    compare<8>( keys, times );
+    compare<16>( keys, times );
+    compare<32>( keys, times );
+    compare<64>( keys, times );
+    return 0;
+}
@@ -0,0 +1,222 @@
+#ifndef BLOCKEDMINIMUMHEAP_H
+#define BLOCKEDMINIMUMHEAP_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "minimumheap.h"
+#include "minimumheaphugepage.h"
+
+/**
+ * A binary minimum heap of Comparable elements in a blocked (page-aware)
+ * layout, for heaps much larger than the last level cache, where each level
+ * of a sift through MinimumHeap's implicit layout touches another cache line
+ * and, below the first few levels, another page and TLB entry.
+ *
+ * The elements are stored in blocks of BlockBytes (default = 4096, one page;
+ * precisely, the largest power of two number of elements which fits, at least
+ * 4). Each block holds two sibling subtrees of the heap, complete and of the
+ * same height, and the children of the leaves of a block are the two roots of
+ * a child block (Kamp, "You're Doing It Wrong", ACM Queue 2010, a B-heap); the
+ * first block holds the root and a single subtree instead. A path from the
+ * root to a leaf thus crosses a block once per log2(block) - 1 levels, and
+ * touches O(log n / log B) pages rather than O(log n), and since siblings are
+ * always stored side by side, choosing the smaller child never touches
+ * another page. Two slots of each block are left unused.
+ *
+ * The heap grows one block at a time, filling the blocks in order and each
+ * block level by level, so that the tree stays complete. pop refills the root
+ * with the last element, sifting it down, and the sift prefetches the
+ * grandchildren of the hole while comparing its children, which hides the
+ * latency of the next block once the path crosses into it.
+ *
+ * Backing the blocks with huge pages (MinimumHeapHugePageAllocator as the
+ * Allocator) reduces the TLB misses further; see
+ * benchmarks/blocked_benchmark.cpp for both against MinimumHeap.
+ *
+ * Comparable must be default constructible (for the unused slots). Elements
+ * are ordered by the Compare function object (default = std::less).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t BlockBytes = 4096,
+          typename Compare = std::less<Comparable>,
+          typename Allocator = std::allocator<Comparable>> class BlockedMinimumHeap {
+
+public:
+
+    /** The number of slots of a block: the largest power of two which fits
+     * in BlockBytes, at least 4. **/
+    static constexpr size_t BlockSlots = [] {
+        size_t slots = 4;
+        while ( 2 * slots * sizeof ( Comparable ) <= BlockBytes )
+            slots *= 2;
+        return slots;
+    } ( );
+
+private:
+
+    /** The number of leaves of a subtree of a block, i.e. its number of
+     * child blocks; the leaves of a block are its slots [Leaves, BlockSlots). **/
+    static constexpr size_t Leaves = BlockSlots / 2;
+
+    /** The slots of the blocks, the slot of block b and position p at
+     * b * BlockSlots + p; positions 0 and 1 are unused but in the first block,
+     * whose position 1 is the root. **/
+    std::vector<Comparable, Allocator> _slots;
+
+    /** The number of elements of the heap. **/
+    size_t _size;
+
+    /** The slot following the last element, i.e. where the next one goes. **/
+    size_t _end;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Produces the slot following the given slot in the order of the heap.
+     */
+    static size_t next ( size_t slot );
+
+    /**
+     * Produces the slot preceding the given slot in the order of the heap.
+     */
+    static size_t previous ( size_t slot );
+
+    /**
+     * Produces the slot of the first child of the given slot (the second is
+     * the next slot).
+     */
+    static size_t firstChild ( size_t slot );
+
+    /**
+     * Produces the slot of the parent of the given slot (not the root).
+     */
+    static size_t parent ( size_t slot );
+
+    /**
+     * Hints the processor to fetch the given slot, if it holds an element.
+     */
+    void prefetch ( size_t slot ) const;
+
+    /**
+     * Sifts the given value down from the hole at the given slot and places it.
+     * @param hole: the slot of the hole.
+     * @param value: the value to be placed.
+     */
+    void siftDown ( size_t hole, Comparable value );
+
+    /**
+     * Sifts the given value up from the hole at the given slot and places it.
+     * @param hole: the slot of the hole.
+     * @param value: the value to be placed.
+     */
+    void siftUp ( size_t hole, Comparable value );
+
+    /**
+     * Adds a slot at the end of the heap, growing it by a block if needed.
+     * @return the slot added.
+     */
+    size_t append ( );
+
+    /**
+     * Removes the root and refills it with the last element.
+     */
+    void fillRoot ( );
+
+public:
+
+    /**
+     * Instantiate an empty BlockedMinimumHeap.
+     * @param compare: the function object used to order the elements.
+     * @param allocator: the allocator of the blocks.
+    **/
+    explicit BlockedMinimumHeap ( const Compare& compare = Compare(), const Allocator& allocator = Allocator() );
+
+    /**
+     * Instantiate a BlockedMinimumHeap by copying elements from the given
+     * vector, then building the heap bottom up (Floyd's method) in O(n).
+     * @param vec: the vector to copy elements from.
+     * @param compare: the function object used to order the elements.
+     * @param allocator: the allocator of the blocks.
+    **/
+    BlockedMinimumHeap ( const std::vector<Comparable>& vec, const Compare& compare = Compare(),
+                         const Allocator& allocator = Allocator() );
+
+    /**
+     * Produces the current size of the BlockedMinimumHeap.
+     * @return number of elements in the BlockedMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the BlockedMinimumHeap is empty (it contains no elements).
+     * @return true if the BlockedMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Resets the BlockedMinimumHeap to be empty. The blocks are kept.
+     */
+    void clear();
+
+    /**
+     * Allocates the blocks for at least the given number of elements, so that
+     * inserting up to that many does not allocate.
+     * @param capacity: the number of elements to make room for.
+     */
+    void reserve ( size_t capacity );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the BlockedMinimumHeap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Inserts the given element into the heap.
+     * @param element: the element to be inserted into the heap
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it.
+     * @param element: the element to be inserted (moved) into the heap
+     */
+    void insert ( Comparable&& element );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the BlockedMinimumHeap is empty
+     */
+    Comparable pop ();
+
+    /**
+     * Moves the element at the top of the heap (the smallest element in the
+     * heap) into the given element and removes it from the heap.
+     * @param element: the element receiving the smallest element.
+     * @throws MinimumHeapUnderflowException if the BlockedMinimumHeap is empty
+     */
+    void pop ( Comparable& element );
+
+    /**
+     * Replaces the element at the top of the heap with the given element,
+     * sifting it down once, and produces the element replaced.
+     * @param element: the element to be inserted into the heap.
+     * @return the value of the smallest element before the replacement.
+     * @throws MinimumHeapUnderflowException if the BlockedMinimumHeap is empty
+     */
+    Comparable replace_top ( Comparable element );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "blockedminimumheap.tpp"
+
+#endif // BLOCKEDMINIMUMHEAP_H
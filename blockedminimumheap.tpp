@@ -0,0 +1,202 @@
+#include "blockedminimumheap.h"
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::next ( size_t slot )
+{
+    slot++;
+    return slot % BlockSlots == 0 ? slot + 2 : slot;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::previous ( size_t slot )
+{
+    slot--;
+    return slot > BlockSlots && slot % BlockSlots == 1 ? slot - 2 : slot;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::firstChild ( size_t slot )
+{
+    size_t block = slot / BlockSlots;
+    size_t position = slot % BlockSlots;
+    if ( position < Leaves )
+        return slot + position;
+    // A leaf: its children are the roots of its child block.
+    return ( block * Leaves + 1 + position - Leaves ) * BlockSlots + 2;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::parent ( size_t slot )
+{
+    size_t block = slot / BlockSlots;
+    size_t position = slot % BlockSlots;
+    if ( block == 0 || position >= 4 )
+        return slot - position + position / 2;
+    // A root of a block: its parent is a leaf of the parent block.
+    return ( block - 1 ) / Leaves * BlockSlots + Leaves + ( block - 1 ) % Leaves;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::prefetch ( size_t slot ) const
+{
+#if defined(__GNUC__)
+    if ( slot < _end )
+        __builtin_prefetch ( _slots.data() + slot );
+#else
+    (void) slot;
+#endif
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::siftDown ( size_t hole, Comparable value )
+{
+    for ( size_t child = firstChild ( hole ); child < _end; child = firstChild ( hole ) )
+    {
+        // The grandchildren: four slots of the same block, or the roots of
+        // two neighbouring child blocks.
+        size_t grandchild = firstChild ( child );
+        prefetch ( grandchild );
+        if ( child % BlockSlots >= Leaves )
+            prefetch ( grandchild + BlockSlots );
+        if ( child + 1 < _end && _compare ( _slots[child + 1], _slots[child] ) )
+            child++;
+        if ( !_compare ( _slots[child], value ) )
+            break;
+        _slots[hole] = std::move ( _slots[child] );
+        hole = child;
+    }
+    _slots[hole] = std::move ( value );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::siftUp ( size_t hole, Comparable value )
+{
+    while ( hole != 1 )
+    {
+        size_t above = parent ( hole );
+        if ( !_compare ( value, _slots[above] ) )
+            break;
+        _slots[hole] = std::move ( _slots[above] );
+        hole = above;
+    }
+    _slots[hole] = std::move ( value );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::append ( )
+{
+    size_t slot = _end;
+    if ( slot >= _slots.size() )
+        _slots.resize ( _slots.size() + BlockSlots );
+    _end = next ( _end );
+    _size++;
+    return slot;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::fillRoot ( )
+{
+    _end = previous ( _end );
+    _size--;
+    if ( _size > 0 )
+        siftDown ( 1, std::move ( _slots[_end] ) );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::BlockedMinimumHeap ( const Compare& compare,
+                                                                                     const Allocator& allocator )
+    : _slots ( allocator ), _size { 0 }, _end { 1 }, _compare { compare } {}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::BlockedMinimumHeap ( const std::vector<Comparable>& vec,
+                                                                                     const Compare& compare,
+                                                                                     const Allocator& allocator )
+    : BlockedMinimumHeap ( compare, allocator )
+{
+    reserve ( vec.size() );
+    for ( const Comparable& element : vec )
+        _slots[append()] = element;
+    // Every slot follows its parent, so sifting the slots in reverse order
+    // sifts each below subtrees which are already heaps.
+    for ( size_t slot = _end; slot > 1; )
+    {
+        slot = previous ( slot );
+        if ( firstChild ( slot ) < _end )
+            siftDown ( slot, std::move ( _slots[slot] ) );
+    }
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+size_t BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::size() const
+{
+    return _size;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+bool BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::clear()
+{
+    _size = 0;
+    _end = 1;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::reserve ( size_t capacity )
+{
+    // The first block holds BlockSlots - 1 elements, the others BlockSlots - 2.
+    size_t blocks = 1;
+    if ( capacity > BlockSlots - 1 )
+        blocks += ( capacity - ( BlockSlots - 1 ) + BlockSlots - 3 ) / ( BlockSlots - 2 );
+    if ( blocks * BlockSlots > _slots.size() )
+        _slots.resize ( blocks * BlockSlots );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+const Comparable& BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _slots[1];
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::insert ( const Comparable& element )
+{
+    siftUp ( append(), element );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::insert ( Comparable&& element )
+{
+    siftUp ( append(), std::move ( element ) );
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+Comparable BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::pop ()
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _slots[1] );
+    fillRoot();
+    return min;
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+void BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::pop ( Comparable& element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    element = std::move ( _slots[1] );
+    fillRoot();
+}
+
+template <typename Comparable, size_t BlockBytes, typename Compare, typename Allocator>
+Comparable BlockedMinimumHeap<Comparable, BlockBytes, Compare, Allocator>::replace_top ( Comparable element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _slots[1] );
+    siftDown ( 1, std::move ( element ) );
+    return min;
+}
@@ -0,0 +1,306 @@
+#ifndef EXTERNALMINIMUMHEAP_H
+#define EXTERNALMINIMUMHEAP_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * @brief Exception: A run of an ExternalMinimumHeap could not be created,
+ * written or read back.
+ */
+class MinimumHeapSpillException {};
+
+/**
+ * An external memory minimum heap of Comparable elements, for workloads which
+ * push far more elements through the heap than fit in memory. It offers the
+ * same insert, top, pop, size and empty operations as MinimumHeap while
+ * keeping its memory within a given budget.
+ *
+ * Inserted elements go into an ordinary MinimumHeap (the insertion buffer),
+ * which never grows beyond half the budget. When the buffer is full, it is
+ * popped in order into a new sorted run: a temporary file written in large
+ * sequential blocks. Each open run keeps its next block in memory, plus a
+ * second block which a background read prefetches while the first is
+ * consumed, and its head (its smallest remaining element) in a small
+ * MinimumHeap of heads. top and pop produce the smaller of the top of the
+ * buffer and the smallest head, so elements inserted after a spill are
+ * ordered with the spilled ones.
+ *
+ * The blocks of the open runs share the other half of the budget, which bounds
+ * their number (the fan-in). When a spill would exceed it, runs are first
+ * merged into a single run, lowest level first: the runs spilled from the
+ * buffer form level 0, and a merge of runs of level l makes a run of level
+ * l + 1. Each element is therefore written and read once by its spill and once
+ * by each merge on its way up the levels, which is close to the sorting bound
+ * of O(n/B log_k(n/M)) block transfers for n elements, blocks of B elements,
+ * a buffer of M elements and a fan-in of k. bytesWritten and bytesRead report
+ * the volume actually transferred.
+ *
+ * Requires a trivially copyable Comparable. Runs are written to uniquely named
+ * files in the given directory (by default the temporary directory of the
+ * system) and removed as soon as they are consumed, or when the heap is
+ * destroyed.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, typename Compare = std::less<Comparable>> class ExternalMinimumHeap {
+
+    static_assert ( std::is_trivially_copyable<Comparable>::value,
+                    "ExternalMinimumHeap requires a trivially copyable Comparable." );
+
+private:
+
+    /**
+     * A sorted run in a temporary file: the block being written or consumed,
+     * the next block being prefetched, and the number of elements in the file
+     * which are not yet in either.
+     */
+    struct Run {
+        std::string path;
+        std::FILE* file;
+        size_t level;
+        std::vector<Comparable> block;
+        size_t position;
+        std::vector<Comparable> next;
+        std::future<size_t> prefetch;
+        uint64_t remaining;
+
+        Run ( const std::string& path, std::FILE* file, size_t level )
+            : path ( path ), file ( file ), level ( level ), position ( 0 ), remaining ( 0 ) {}
+
+        Run ( const Run& rhs ) = delete;
+        Run& operator= ( const Run& rhs ) = delete;
+
+        ~Run ( )
+        {
+            if ( prefetch.valid() )
+                prefetch.wait();
+            std::fclose ( file );
+            std::remove ( path.c_str() );
+        }
+    };
+
+    /** The head of an open run in the heap of heads. **/
+    struct Head {
+        Comparable value;
+        Run* run;
+    };
+
+    /** Orders heads by their values. **/
+    struct HeadCompare {
+        Compare compare;
+
+        bool operator() ( const Head& lhs, const Head& rhs ) { return compare ( lhs.value, rhs.value ); }
+    };
+
+    typedef MinimumHeap<Head, 2, MinimumHeapPop::TopDown, HeadCompare> Heads;
+
+    /** The function object used to order the elements (mutable: top compares
+     * the top of the buffer with the smallest head). **/
+    mutable Compare _compare;
+
+    /** The number of elements in a block of a run. **/
+    size_t _block;
+
+    /** The number of elements the insertion buffer may hold. **/
+    size_t _bufferCapacity;
+
+    /** The largest number of open runs. **/
+    size_t _fanIn;
+
+    /** The insertion buffer. **/
+    MinimumHeap<Comparable, 2, MinimumHeapPop::TopDown, Compare> _buffer;
+
+    /** The heads of the open runs. **/
+    Heads _heads;
+
+    /** The open runs. **/
+    std::vector<std::unique_ptr<Run>> _runs;
+
+    /** The directory of the run files. **/
+    std::string _directory;
+
+    /** The prefix of the names of the run files, unique to this heap. **/
+    std::string _prefix;
+
+    /** The number of runs created, numbering the run files. **/
+    uint64_t _created;
+
+    /** The current size of the ExternalMinimumHeap. **/
+    size_t _size;
+
+    /** The number of bytes written to and read from run files. **/
+    uint64_t _bytesWritten;
+    uint64_t _bytesRead;
+
+    /**
+     * Creates an empty run file of the given level.
+     * @throws MinimumHeapSpillException if the file cannot be created
+     */
+    std::unique_ptr<Run> create ( size_t level );
+
+    /**
+     * Appends the given element to the given run being written.
+     */
+    void append ( Run& run, const Comparable& element );
+
+    /**
+     * Writes the block of the given run to its file.
+     * @throws MinimumHeapSpillException if the write fails
+     */
+    void flush ( Run& run );
+
+    /**
+     * Completes the given written run, reads its first block, and adds the
+     * run to the open runs and its head to the heap of heads.
+     */
+    void open ( std::unique_ptr<Run> run );
+
+    /**
+     * Starts the background read of the next block of the given run, if any.
+     */
+    void prefetch ( Run& run );
+
+    /**
+     * Advances the given run to its next element, taking the prefetched block
+     * when its current block is consumed.
+     * @return true if the run has a next element, false if it is consumed.
+     * @throws MinimumHeapSpillException if a read fails
+     */
+    bool advance ( Run& run );
+
+    /**
+     * Removes the smallest head from the given heap of heads, replacing it by
+     * the next element of its run, or closing the run if it is consumed.
+     * @return the value of the smallest head.
+     */
+    Comparable take ( Heads& heads );
+
+    /**
+     * Merges the open runs of the lowest level (and those of the next level
+     * if the lowest has a single run) into one run of the next level.
+     */
+    void merge ( );
+
+    /**
+     * Writes the insertion buffer to a new run of level 0, merging runs
+     * first if there is no room for another open run.
+     */
+    void spill ( );
+
+public:
+
+    /**
+     * Instantiate an empty ExternalMinimumHeap.
+     * @param budget: the memory the heap may use for its elements, in bytes
+     * (default = 64 MiB). Half of it holds the insertion buffer, the other
+     * half the blocks of the open runs.
+     * @param block: the size of the blocks the runs are written and read in,
+     * in bytes (default = 1 MiB), reduced to a sixteenth of the budget if
+     * larger.
+     * @param directory: the directory of the run files (default = the
+     * temporary directory of the system).
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit ExternalMinimumHeap ( size_t budget = 64 << 20, size_t block = 1 << 20,
+                                   const std::string& directory = "",
+                                   const Compare& compare = Compare() );
+
+    ExternalMinimumHeap ( const ExternalMinimumHeap& rhs ) = delete;
+    ExternalMinimumHeap& operator= ( const ExternalMinimumHeap& rhs ) = delete;
+
+    ExternalMinimumHeap ( ExternalMinimumHeap&& rhs ) = default;
+    ExternalMinimumHeap& operator= ( ExternalMinimumHeap&& rhs ) = default;
+
+    /**
+     * Produces the current size of the ExternalMinimumHeap.
+     * @return number of elements in the ExternalMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the ExternalMinimumHeap is empty (it contains no elements).
+     * @return true if the ExternalMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the ExternalMinimumHeap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Inserts the given element into the heap, first spilling the insertion
+     * buffer to a run if it is full.
+     * @param element: the element to be inserted into the heap
+     * @throws MinimumHeapSpillException if a run cannot be written
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the ExternalMinimumHeap is empty
+     * @throws MinimumHeapSpillException if a run cannot be read
+     */
+    Comparable pop ();
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) into the given parameter and removes it from the heap.
+     * @param element: the variable that will contain the smallest element
+     * from the heap, if such an element exists.
+     * @throws MinimumHeapUnderflowException if the ExternalMinimumHeap is empty
+     * @throws MinimumHeapSpillException if a run cannot be read
+     */
+    void pop ( Comparable& element );
+
+    /**
+     * Produces the number of runs currently open (on disk).
+     * @return the number of open runs.
+     */
+    size_t runs ( ) const;
+
+    /**
+     * Produces the largest number of runs open at once, set by the budget.
+     * @return the fan-in of the merges.
+     */
+    size_t fanIn ( ) const;
+
+    /**
+     * Produces the number of elements the insertion buffer holds before it
+     * is spilled, set by the budget.
+     * @return the capacity of the insertion buffer.
+     */
+    size_t bufferCapacity ( ) const;
+
+    /**
+     * Produces the number of bytes written to run files so far.
+     * @return the number of bytes written.
+     */
+    uint64_t bytesWritten ( ) const;
+
+    /**
+     * Produces the number of bytes read from run files so far.
+     * @return the number of bytes read.
+     */
+    uint64_t bytesRead ( ) const;
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "externalminimumheap.tpp"
+
+#endif // EXTERNALMINIMUMHEAP_H
@@ -0,0 +1,241 @@
+#include "externalminimumheap.h"
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+template <typename Comparable, typename Compare>
+ExternalMinimumHeap<Comparable, Compare>::ExternalMinimumHeap ( size_t budget, size_t block,
+                                                               const std::string& directory,
+                                                               const Compare& compare )
+    : _compare { compare },
+      _block { std::max<size_t> ( 1, std::min ( block, budget / 16 ) / sizeof ( Comparable ) ) },
+      _bufferCapacity { std::max<size_t> ( 1, budget / 2 / sizeof ( Comparable ) ) },
+      _fanIn { std::max<size_t> ( 2, ( _bufferCapacity - _block ) / ( 2 * _block ) ) },
+      _buffer ( _bufferCapacity, compare ),
+      _heads ( _fanIn + 1, HeadCompare { compare } ),
+      _directory { directory.empty() ? std::filesystem::temp_directory_path().string() : directory },
+      _created { 0 }, _size { 0 }, _bytesWritten { 0 }, _bytesRead { 0 }
+{
+    std::random_device random;
+    _prefix = "minimumheap-" + std::to_string ( random() ) + "-" + std::to_string ( random() ) + "-";
+}
+
+template <typename Comparable, typename Compare>
+std::unique_ptr<typename ExternalMinimumHeap<Comparable, Compare>::Run> ExternalMinimumHeap<Comparable, Compare>::create ( size_t level )
+{
+    std::string path = ( std::filesystem::path ( _directory )
+                         / ( _prefix + std::to_string ( _created++ ) + ".run" ) ).string();
+    std::FILE* file = std::fopen ( path.c_str(), "w+b" );
+    if ( file == nullptr ) { throw MinimumHeapSpillException(); }
+    // The runs are written and read in whole blocks: no stdio buffer.
+    std::setvbuf ( file, nullptr, _IONBF, 0 );
+    std::unique_ptr<Run> run ( new Run ( path, file, level ) );
+    run->block.reserve ( _block );
+    return run;
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::append ( Run& run, const Comparable& element )
+{
+    run.block.push_back ( element );
+    if ( run.block.size() == _block )
+        flush ( run );
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::flush ( Run& run )
+{
+    if ( std::fwrite ( run.block.data(), sizeof ( Comparable ), run.block.size(), run.file ) != run.block.size() )
+        throw MinimumHeapSpillException();
+    _bytesWritten += run.block.size() * sizeof ( Comparable );
+    run.remaining += run.block.size();
+    run.block.clear();
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::open ( std::unique_ptr<Run> run )
+{
+    flush ( *run );
+    if ( std::fflush ( run->file ) != 0 || std::fseek ( run->file, 0, SEEK_SET ) != 0 )
+        throw MinimumHeapSpillException();
+    prefetch ( *run );
+    if ( !advance ( *run ) )
+        return;
+    _heads.insert ( Head { run->block[0], run.get() } );
+    _runs.push_back ( std::move ( run ) );
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::prefetch ( Run& run )
+{
+    if ( run.remaining == 0 )
+        return;
+    size_t count = static_cast<size_t> ( std::min<uint64_t> ( _block, run.remaining ) );
+    run.remaining -= count;
+    run.next.resize ( count );
+    Comparable* data = run.next.data();
+    std::FILE* file = run.file;
+    run.prefetch = std::async ( std::launch::async, [data, count, file] ( )
+    {
+        return std::fread ( data, sizeof ( Comparable ), count, file );
+    } );
+}
+
+template <typename Comparable, typename Compare>
+bool ExternalMinimumHeap<Comparable, Compare>::advance ( Run& run )
+{
+    if ( ++run.position < run.block.size() )
+        return true;
+    if ( !run.prefetch.valid() )
+        return false;
+    if ( run.prefetch.get() != run.next.size() ) { throw MinimumHeapSpillException(); }
+    _bytesRead += run.next.size() * sizeof ( Comparable );
+    std::swap ( run.block, run.next );
+    run.position = 0;
+    prefetch ( run );
+    return true;
+}
+
+template <typename Comparable, typename Compare>
+Comparable ExternalMinimumHeap<Comparable, Compare>::take ( Heads& heads )
+{
+    Head head = heads.top();
+    Run& run = *head.run;
+    if ( advance ( run ) )
+    {
+        heads.replace_top ( Head { run.block[run.position], &run } );
+    }
+    else
+    {
+        heads.pop();
+        _runs.erase ( std::find_if ( _runs.begin(), _runs.end(),
+                                     [&run] ( const std::unique_ptr<Run>& open ) { return open.get() == &run; } ) );
+    }
+    return head.value;
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::merge ( )
+{
+    // The lowest level, and the next one if the lowest has a single run.
+    size_t lowest = SIZE_MAX;
+    for ( const std::unique_ptr<Run>& run : _runs )
+        lowest = std::min ( lowest, run->level );
+    size_t highest = lowest;
+    if ( std::count_if ( _runs.begin(), _runs.end(),
+                         [lowest] ( const std::unique_ptr<Run>& run ) { return run->level == lowest; } ) < 2 )
+    {
+        highest = SIZE_MAX;
+        for ( const std::unique_ptr<Run>& run : _runs )
+            if ( run->level > lowest )
+                highest = std::min ( highest, run->level );
+    }
+
+    std::vector<Head> rest;
+    std::vector<Head> merged;
+    while ( !_heads.empty() )
+    {
+        Head head = _heads.pop();
+        ( head.run->level <= highest ? merged : rest ).push_back ( head );
+    }
+    _heads = Heads ( std::move ( rest ), HeadCompare { _compare } );
+
+    Heads heads ( std::move ( merged ), HeadCompare { _compare } );
+    std::unique_ptr<Run> run = create ( highest + 1 );
+    while ( !heads.empty() )
+        append ( *run, take ( heads ) );
+    open ( std::move ( run ) );
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::spill ( )
+{
+    if ( _runs.size() >= _fanIn )
+        merge();
+    std::unique_ptr<Run> run = create ( 0 );
+    while ( !_buffer.empty() )
+        append ( *run, _buffer.pop() );
+    open ( std::move ( run ) );
+}
+
+template <typename Comparable, typename Compare>
+size_t ExternalMinimumHeap<Comparable, Compare>::size() const
+{
+    return _size;
+}
+
+template <typename Comparable, typename Compare>
+bool ExternalMinimumHeap<Comparable, Compare>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Comparable, typename Compare>
+const Comparable& ExternalMinimumHeap<Comparable, Compare>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    if ( _heads.empty() || ( !_buffer.empty() && !_compare ( _heads.top().value, _buffer.top() ) ) )
+        return _buffer.top();
+    return _heads.top().value;
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::insert ( const Comparable& element )
+{
+    if ( _buffer.size() >= _bufferCapacity )
+        spill();
+    _buffer.insert ( element );
+    _size++;
+}
+
+template <typename Comparable, typename Compare>
+Comparable ExternalMinimumHeap<Comparable, Compare>::pop ()
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable element = _heads.empty() || ( !_buffer.empty() && !_compare ( _heads.top().value, _buffer.top() ) )
+            ? _buffer.pop()
+            : take ( _heads );
+    _size--;
+    return element;
+}
+
+template <typename Comparable, typename Compare>
+void ExternalMinimumHeap<Comparable, Compare>::pop ( Comparable& element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    if ( _heads.empty() || ( !_buffer.empty() && !_compare ( _heads.top().value, _buffer.top() ) ) )
+        _buffer.pop ( element );
+    else
+        element = take ( _heads );
+    _size--;
+}
+
+template <typename Comparable, typename Compare>
+size_t ExternalMinimumHeap<Comparable, Compare>::runs ( ) const
+{
+    return _runs.size();
+}
+
+template <typename Comparable, typename Compare>
+size_t ExternalMinimumHeap<Comparable, Compare>::fanIn ( ) const
+{
+    return _fanIn;
+}
+
+template <typename Comparable, typename Compare>
+size_t ExternalMinimumHeap<Comparable, Compare>::bufferCapacity ( ) const
+{
+    return _bufferCapacity;
+}
+
+template <typename Comparable, typename Compare>
+uint64_t ExternalMinimumHeap<Comparable, Compare>::bytesWritten ( ) const
+{
+    return _bytesWritten;
+}
+
+template <typename Comparable, typename Compare>
+uint64_t ExternalMinimumHeap<Comparable, Compare>::bytesRead ( ) const
+{
+    return _bytesRead;
+}
@@ -0,0 +1,188 @@
+#ifndef FLATCOMBININGHEAP_H
+#define FLATCOMBININGHEAP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * An exact (linearizable) concurrent priority queue of Comparable elements,
+ * safe to use from any number of threads at once, for consumers that need
+ * strict priority order where a MultiQueue's relaxed pop will not do.
+ *
+ * A MinimumHeap guarded by a mutex collapses under contention: every
+ * operation moves the lock's cache line and the top of the heap between
+ * cores. Here (flat combining, Hendler, Incze, Shavit and Tzafrir, SPAA 2010)
+ * a thread instead publishes its request in a slot of its own (one per cache
+ * line) and waits for it to be served. Whichever waiting thread takes the
+ * combiner lock serves the requests of every slot as one batch, so the heap
+ * is only ever touched by one thread at a time, and the others spin on their
+ * own slot. The batched inserts go through MinimumHeap::insert_range and the
+ * batched pops take the k smallest elements at once through
+ * MinimumHeap::pop_n. Within a batch the inserts are applied before the pops.
+ *
+ * The queue has a fixed number of slots, given as the expected number of
+ * threads; more threads than slots wait for a free slot. Comparable must be
+ * default constructible.
+ *
+ * An exception thrown while a batch is combined (e.g. std::bad_alloc as the
+ * heap grows, or a throwing move of an element) fails only the requests it
+ * concerns: it is rethrown by their insert or try_pop, in their own threads,
+ * and the combiner lock is released. An exception within insert_range fails
+ * every insert of the batch, none of which is inserted (insert_range leaves
+ * the heap as it was). A failed insert has not inserted its element; a
+ * failed pop may have removed its element (the heap offers only
+ * the basic guarantee when moving an element throws).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          typename Compare = std::less<Comparable>> class FlatCombiningHeap {
+
+private:
+
+    /** The states of a slot. **/
+    enum State : int { Free, Claimed, Insert, Pop, Done };
+
+    /** A request published by a thread, alone on its cache line. **/
+    struct alignas(64) Slot {
+        std::atomic<int> state { Free };
+        Comparable element;
+        bool found = false;
+        std::exception_ptr error;
+    };
+
+    /** The elements of the queue, only touched by the combiner. **/
+    MinimumHeap<Comparable, Arity, MinimumHeapPop::TopDown, Compare> _heap;
+
+    /** The published requests. **/
+    std::unique_ptr<Slot[]> _slots;
+
+    /** The number of slots. **/
+    size_t _count;
+
+    /** Held by the thread combining the requests. **/
+    alignas(64) std::atomic<bool> _combining;
+
+    /** The number of elements in the queue. **/
+    alignas(64) std::atomic<size_t> _size;
+
+    /** The elements inserted, the insert requests and the pop requests of
+     * the current batch, reused by every combiner. **/
+    std::vector<Comparable> _inserts;
+    std::vector<Slot*> _served;
+    std::vector<Slot*> _pops;
+    std::vector<Comparable> _minima;
+
+    /**
+     * Claims a free slot for the calling thread, starting from one chosen by
+     * its id, waiting for one to be freed if all are in use.
+     * @return the slot, in the Claimed state.
+     */
+    Slot& claim ( );
+
+    /**
+     * Publishes the request of the given claimed slot and waits for it to
+     * be served, combining the pending requests whenever the combiner lock
+     * is free. The slot is left Done.
+     * @param slot: the slot of the calling thread.
+     * @param request: Insert or Pop.
+     */
+    void publish ( Slot& slot, State request );
+
+    /**
+     * Serves every published request as one batch: the inserts through
+     * insert_range, then the pops through pop_n. Called with the combiner
+     * lock held; never throws, failing the requests concerned instead.
+     */
+    void combine ( );
+
+    /**
+     * Marks the given request as served, with the given error (if any).
+     * @param slot: the slot of the request.
+     * @param error: the exception to rethrow in the requesting thread.
+     */
+    void serve ( Slot& slot, const std::exception_ptr& error );
+
+    /**
+     * Frees the given served slot, rethrowing its error, if any.
+     * @param slot: the slot of the calling thread.
+     */
+    void release ( Slot& slot );
+
+public:
+
+    /**
+     * Instantiate an empty FlatCombiningHeap.
+     * @param threads: the expected number of threads, the number of slots
+     * (default = the number of hardware threads).
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit FlatCombiningHeap ( size_t threads = std::thread::hardware_concurrency(),
+                                 const Compare& compare = Compare() );
+
+    FlatCombiningHeap ( const FlatCombiningHeap& rhs ) = delete;
+    FlatCombiningHeap& operator= ( const FlatCombiningHeap& rhs ) = delete;
+
+    /**
+     * Produces the number of request slots.
+     * @return the number of slots.
+     */
+    size_t slots() const;
+
+    /**
+     * Produces the current size of the FlatCombiningHeap. The size may already
+     * have changed by the time it is returned if other threads are using the
+     * queue.
+     * @return number of elements in the FlatCombiningHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the FlatCombiningHeap is empty (it contains no elements).
+     * @return true if the FlatCombiningHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Inserts the given element into the queue.
+     * @param element: the element to be inserted into the queue
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the queue by moving it.
+     * @param element: the element to be inserted (moved) into the queue
+     */
+    void insert ( Comparable&& element );
+
+    /**
+     * Removes the smallest element from the queue, moving it to the given
+     * parameter.
+     * @param element: the variable that will contain the removed element, if
+     * such an element exists.
+     * @return true if an element was removed, false if the queue was empty.
+     */
+    bool try_pop ( Comparable& element );
+
+    /**
+     * Removes the smallest element from the queue.
+     * @return the removed element.
+     * @throws MinimumHeapUnderflowException if the FlatCombiningHeap is empty
+     */
+    Comparable pop ();
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "flatcombiningheap.tpp"
+
+#endif // FLATCOMBININGHEAP_H
@@ -0,0 +1,200 @@
+#include "flatcombiningheap.h"
+
+template <typename Comparable, size_t Arity, typename Compare>
+typename FlatCombiningHeap<Comparable, Arity, Compare>::Slot& FlatCombiningHeap<Comparable, Arity, Compare>::claim ( )
+{
+    thread_local size_t hint = std::hash<std::thread::id>() ( std::this_thread::get_id() );
+    for ( ;; )
+    {
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            Slot& slot = _slots[( hint + i ) % _count];
+            int free = Free;
+            if ( slot.state.load ( std::memory_order_relaxed ) == Free
+                 && slot.state.compare_exchange_strong ( free, Claimed, std::memory_order_acquire ) )
+            {
+                hint += i;
+                return slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::publish ( Slot& slot, State request )
+{
+    // Releases the combiner lock however combine() ends.
+    struct Release {
+        std::atomic<bool>& combining;
+        ~Release ( ) { combining.store ( false, std::memory_order_release ); }
+    };
+
+    slot.state.store ( request, std::memory_order_release );
+    while ( slot.state.load ( std::memory_order_acquire ) != Done )
+    {
+        if ( !_combining.load ( std::memory_order_relaxed )
+             && !_combining.exchange ( true, std::memory_order_acquire ) )
+        {
+            Release release { _combining };
+            combine();
+        }
+        else
+            std::this_thread::yield();
+    }
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::serve ( Slot& slot, const std::exception_ptr& error )
+{
+    slot.error = error;
+    slot.state.store ( Done, std::memory_order_release );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::release ( Slot& slot )
+{
+    std::exception_ptr error = std::move ( slot.error );
+    slot.error = nullptr;
+    slot.state.store ( Free, std::memory_order_release );
+    if ( error )
+        std::rethrow_exception ( error );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::combine ( )
+{
+    // The vectors were reserved for every slot: collecting the requests does
+    // not allocate. Whatever throws fails the requests it concerns, which are
+    // rethrown in their own threads; the others are served.
+    _inserts.clear();
+    _pops.clear();
+    _served.clear();
+    for ( size_t i = 0; i < _count; i++ )
+    {
+        Slot& slot = _slots[i];
+        int state = slot.state.load ( std::memory_order_acquire );
+        if ( state == Insert )
+        {
+            try
+            {
+                _inserts.push_back ( std::move ( slot.element ) );
+                _served.push_back ( &slot );
+            }
+            catch ( ... ) { serve ( slot, std::current_exception() ); }
+        }
+        else if ( state == Pop )
+            _pops.push_back ( &slot );
+    }
+
+    if ( !_inserts.empty() )
+    {
+        std::exception_ptr error;
+        try
+        {
+            _heap.insert_range ( std::make_move_iterator ( _inserts.begin() ),
+                                 std::make_move_iterator ( _inserts.end() ) );
+        }
+        catch ( ... ) { error = std::current_exception(); }
+        for ( Slot* slot : _served )
+            serve ( *slot, error );
+    }
+    if ( !_pops.empty() )
+    {
+        size_t k = std::min ( _pops.size(), _heap.size() );
+        std::exception_ptr error;
+        _minima.clear();
+        try { _heap.pop_n ( k, std::back_inserter ( _minima ) ); }
+        catch ( ... ) { error = std::current_exception(); }
+        for ( size_t i = 0; i < _pops.size(); i++ )
+        {
+            Slot& slot = *_pops[i];
+            slot.found = !error && i < k;
+            if ( slot.found )
+            {
+                try { slot.element = std::move ( _minima[i] ); }
+                catch ( ... ) { serve ( slot, std::current_exception() ); continue; }
+            }
+            serve ( slot, error );
+        }
+    }
+    _size.store ( _heap.size(), std::memory_order_relaxed );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+FlatCombiningHeap<Comparable, Arity, Compare>::FlatCombiningHeap ( size_t threads, const Compare& compare )
+    : _heap ( 2, compare ), _count { std::max<size_t> ( 1, threads ) }, _combining { false }, _size { 0 }
+{
+    _slots.reset ( new Slot[_count] );
+    _inserts.reserve ( _count );
+    _served.reserve ( _count );
+    _pops.reserve ( _count );
+    _minima.reserve ( _count );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t FlatCombiningHeap<Comparable, Arity, Compare>::slots() const
+{
+    return _count;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t FlatCombiningHeap<Comparable, Arity, Compare>::size() const
+{
+    return _size.load ( std::memory_order_relaxed );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool FlatCombiningHeap<Comparable, Arity, Compare>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::insert ( const Comparable& element )
+{
+    Comparable copy = element;
+    insert ( std::move ( copy ) );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void FlatCombiningHeap<Comparable, Arity, Compare>::insert ( Comparable&& element )
+{
+    Slot& slot = claim();
+    try { slot.element = std::move ( element ); }
+    catch ( ... )
+    {
+        slot.state.store ( Free, std::memory_order_release );
+        throw;
+    }
+    publish ( slot, Insert );
+    release ( slot );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool FlatCombiningHeap<Comparable, Arity, Compare>::try_pop ( Comparable& element )
+{
+    Slot& slot = claim();
+    publish ( slot, Pop );
+    bool found = slot.found;
+    if ( found )
+    {
+        try { element = std::move ( slot.element ); }
+        catch ( ... )
+        {
+            slot.error = nullptr;
+            slot.state.store ( Free, std::memory_order_release );
+            throw;
+        }
+    }
+    release ( slot );
+    return found;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+Comparable FlatCombiningHeap<Comparable, Arity, Compare>::pop ()
+{
+    Comparable element;
+    if ( !try_pop ( element ) ) { throw MinimumHeapUnderflowException(); }
+    return element;
+}
@@ -0,0 +1,153 @@
+#ifndef KEYEDMINIMUMHEAP_H
+#define KEYEDMINIMUMHEAP_H
+
+#include <vector>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "minimumheap.h"
+
+/**
+ * A minimum heap of Value elements ordered by a key projected from each value
+ * (e.g. a job record ordered by its deadline), with the keys and the values
+ * stored apart.
+ *
+ * The keys are held in a dense MinimumHeap of (key, slot) entries, and the
+ * values are held in a parallel vector indexed by slot. Sifting only compares
+ * and moves the compact entries, so the cache holds many more keys than it
+ * would whole values; each value is moved into the heap once on insert and out
+ * of the heap once when it is popped, when its slot is destroyed so that it
+ * keeps no resources of the popped value. The slots of popped values are
+ * reused by later inserts.
+ *
+ * KeyOf is a function object producing the key of a value; keys are ordered
+ * by the Compare function object (default = std::less, i.e. the less than
+ * operator of the key). Neither Value nor the key need a less than operator
+ * of their own.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Value, typename KeyOf,
+          typename Compare = std::less<typename std::decay<decltype (
+                  std::declval<KeyOf&>() ( std::declval<const Value&>() ) )>::type>,
+          size_t Arity = 2, MinimumHeapPop Pop = MinimumHeapPop::TopDown>
+class KeyedMinimumHeap {
+
+public:
+
+    /** The type of the key projected from each value. **/
+    typedef typename std::decay<decltype (
+            std::declval<KeyOf&>() ( std::declval<const Value&>() ) )>::type Key;
+
+private:
+
+    /** A key in the heap with the slot holding its value. **/
+    struct Entry {
+        Key key;
+        size_t slot;
+    };
+
+    /** Orders entries by their keys. **/
+    struct EntryLess {
+        Compare compare;
+        bool operator() ( const Entry& lhs, const Entry& rhs ) { return compare ( lhs.key, rhs.key ); }
+    };
+
+    /** The keys of the heap. **/
+    MinimumHeap<Entry, Arity, Pop, EntryLess> _keys;
+
+    /** The values of the heap, indexed by slot; free slots are empty. **/
+    std::vector<std::optional<Value>> _values;
+
+    /** The slots of _values that are not currently in use. **/
+    std::vector<size_t> _freeSlots;
+
+    /** The function object used to project keys from values. **/
+    KeyOf _keyOf;
+
+    /**
+     * Stores the given value in a free slot.
+     * @param value: the value to be stored (moved).
+     * @return the slot holding the value.
+     */
+    size_t store ( Value&& value );
+
+public:
+
+    /**
+     * Instantiate a KeyedMinimumHeap given the initial capacity (default = 2)
+     * of the underlying vectors.
+     * @param capacity: the initial capacity.
+     * @param keyOf: the function object used to project keys from values.
+     * @param compare: the function object used to order the keys.
+    **/
+    explicit KeyedMinimumHeap ( size_t capacity = 2, const KeyOf& keyOf = KeyOf(),
+                                const Compare& compare = Compare() );
+
+    /**
+     * Produces the current size of the KeyedMinimumHeap.
+     * @return number of elements in the KeyedMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the KeyedMinimumHeap is empty (it contains no elements).
+     * @return true if the KeyedMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Resets the KeyedMinimumHeap to be empty (it will contain no elements).
+     */
+    void clear();
+
+    /**
+     * Produces the value with the smallest key without removing it.
+     * @return the value with the smallest key.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    const Value& top ( ) const;
+
+    /**
+     * Produces the smallest key in the heap.
+     * @return the smallest key.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    const Key& top_key ( ) const;
+
+    /**
+     * Inserts the given value into the heap according to its key.
+     * @param value: the value to be inserted into the heap
+     */
+    void insert ( const Value& value );
+
+    /**
+     * Inserts the given value into the heap according to its key by moving it.
+     * @param value: the value to be inserted (moved) into the heap
+     */
+    void insert ( Value&& value );
+
+    /**
+     * Produces the value with the smallest key and removes it from the heap.
+     * @return the value with the smallest key.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    Value pop ();
+
+    /**
+     * Produces the value with the smallest key, moving it to the given
+     * parameter, and removes it from the heap.
+     * @param value: the variable that will contain the value with the
+     * smallest key, if such a value exists.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    void pop ( Value& value );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "keyedminimumheap.tpp"
+
+#endif // KEYEDMINIMUMHEAP_H
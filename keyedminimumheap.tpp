@@ -0,0 +1,91 @@
+#include "keyedminimumheap.h"
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+size_t KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::store ( Value&& value )
+{
+    if ( _freeSlots.empty() )
+    {
+        _values.emplace_back ( std::in_place, std::move ( value ) );
+        return _values.size() - 1;
+    }
+    size_t slot = _freeSlots.back();
+    _values[slot].emplace ( std::move ( value ) );
+    _freeSlots.pop_back();
+    return slot;
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::KeyedMinimumHeap ( size_t capacity,
+                                                                       const KeyOf& keyOf,
+                                                                       const Compare& compare )
+    : _keys ( capacity, EntryLess { compare } ), _keyOf{ keyOf }
+{
+    _values.reserve ( capacity );
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+size_t KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::size() const
+{
+    return _keys.size();
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+bool KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::empty() const
+{
+    return _keys.empty();
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+void KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::clear()
+{
+    _keys.clear();
+    _values.clear();
+    _freeSlots.clear();
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+const Value& KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::top ( ) const
+{
+    return *_values[_keys.top().slot];
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+const typename KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::Key&
+KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::top_key ( ) const
+{
+    return _keys.top().key;
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+void KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::insert ( const Value& value )
+{
+    Value copy = value;
+    insert ( std::move ( copy ) );
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+void KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::insert ( Value&& value )
+{
+    Key key = _keyOf ( value );
+    size_t slot = store ( std::move ( value ) );
+    _keys.insert ( Entry { std::move ( key ), slot } );
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+Value KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::pop ()
+{
+    size_t slot = _keys.pop().slot;
+    _freeSlots.push_back ( slot );
+    Value value = std::move ( *_values[slot] );
+    _values[slot].reset();
+    return value;
+}
+
+template <typename Value, typename KeyOf, typename Compare, size_t Arity, MinimumHeapPop Pop>
+void KeyedMinimumHeap<Value, KeyOf, Compare, Arity, Pop>::pop ( Value& value )
+{
+    size_t slot = _keys.pop().slot;
+    _freeSlots.push_back ( slot );
+    value = std::move ( *_values[slot] );
+    _values[slot].reset();
+}
@@ -0,0 +1,185 @@
+#ifndef KWAYMERGE_H
+#define KWAYMERGE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * A k-way merge of sorted sources of Comparable elements into one sorted
+ * sequence, for merging the sorted outputs of many shards (e.g. compaction).
+ *
+ * The sources are kept in a tournament tree of losers (Knuth, TAOCP vol. 3,
+ * 5.4.1): each of the k - 1 internal nodes holds the source which lost the
+ * match played there, and the overall winner, the source with the smallest
+ * current element, is kept above the root. Taking the smallest element
+ * replaces the winner's element by the next one of the same source and
+ * replays only the matches on its path to the root: one comparison per level,
+ * against the loser stored there, decided without a branch, and no other
+ * source is touched. A MinimumHeap of (element, source) pairs does the same
+ * job with a pop and an insert, about twice the comparisons and moves, or a
+ * replace_top, which still compares the children at every level.
+ *
+ * A source is either a range of iterators or a generator: a function object
+ * size_t ( Comparable* batch, size_t capacity ) which fills up to capacity
+ * elements of the batch and produces their number (0 once exhausted). Each
+ * source is read a batch at a time into a buffer of its own, so the (type
+ * erased) source is called once per batch and the merge itself only advances
+ * a pointer per element. Exhausted sources lose every match.
+ *
+ * The order in which equal elements of different sources are produced is
+ * unspecified (breaking ties by source would cost a second comparison per
+ * match). Comparable must be default constructible (for the buffers).
+ * A source added once the merge has started joins it with its first element.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, typename Compare = std::less<Comparable>> class KWayMerge {
+
+public:
+
+    /** A source of batches of sorted elements. **/
+    typedef std::function<size_t ( Comparable*, size_t )> Generator;
+
+private:
+
+    /** The sources of the merge. **/
+    std::vector<Generator> _sources;
+
+    /** The current batch of each source. **/
+    std::vector<std::vector<Comparable>> _batches;
+
+    /** The next element of the current batch of each source. **/
+    std::vector<Comparable*> _current;
+
+    /** The end of the current batch of each source. **/
+    std::vector<Comparable*> _end;
+
+    /** The current element of each source (the keys played, contiguous so
+     * that a replay touches one array), and whether the source is exhausted. **/
+    std::vector<Comparable> _keys;
+    std::vector<char> _exhausted;
+
+    /** The tree: the source which lost the match at each internal node n in
+     * [1, k), whose children are 2n and 2n + 1, with leaf k + i for source
+     * i; the winner is at _tree[0]. **/
+    std::vector<size_t> _tree;
+
+    /** The number of elements per batch. **/
+    size_t _batch;
+
+    /** The number of sources read from and played in the tree. **/
+    size_t _playing;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Determines if source a wins the match against source b: a has an
+     * element and b is exhausted, or the element of a is smaller.
+     */
+    bool beats ( size_t a, size_t b );
+
+    /**
+     * Moves the next element of the given source into its key, reading the
+     * next batch of the source when needed, or marks the source exhausted.
+     * @return true if the source has an element, false if it is exhausted.
+     */
+    bool next ( size_t source );
+
+    /**
+     * Plays the matches of the subtree of the given node, storing the losers.
+     * @return the winner of the subtree.
+     */
+    size_t play ( size_t node );
+
+    /**
+     * Reads the first batch of each source added since the tree was last
+     * built, and builds the tree again, if any.
+     */
+    void build ( );
+
+    /**
+     * Advances the winner to the next element of its source and replays the
+     * matches on its path to the root.
+     */
+    void replaceWinner ( );
+
+public:
+
+    /**
+     * Instantiate an empty KWayMerge.
+     * @param batch: the number of elements read from a source at once
+     * (default = 128).
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit KWayMerge ( size_t batch = 128, const Compare& compare = Compare() );
+
+    /**
+     * Adds the sorted range [first, last) as a source. The range must remain
+     * valid until the merge has read it.
+     * @param first: the first element of the range.
+     * @param last: one past the last element of the range.
+     */
+    template <typename Iterator>
+    void add ( Iterator first, Iterator last );
+
+    /**
+     * Adds the given generator of sorted batches as a source.
+     * @param generator: the function object filling batches (see above).
+     */
+    void add ( Generator generator );
+
+    /**
+     * Produces the number of sources (including exhausted ones).
+     * @return number of sources.
+     */
+    size_t sources() const;
+
+    /**
+     * Determines if every source is exhausted.
+     * @return true if no element remains, false otherwise.
+     */
+    bool empty();
+
+    /**
+     * Produces the smallest remaining element without removing it.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if every source is exhausted
+     */
+    const Comparable& top ( );
+
+    /**
+     * Produces the smallest remaining element and removes it.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if every source is exhausted
+     */
+    Comparable pop ( );
+
+    /**
+     * Removes up to k of the smallest remaining elements, moving them in
+     * ascending order to the given output iterator.
+     * @param k: the largest number of elements to be removed.
+     * @param out: the destination of the removed elements.
+     * @return the output iterator past the last element written.
+     */
+    template <typename OutputIterator>
+    OutputIterator pop_n ( size_t k, OutputIterator out );
+
+    /**
+     * Removes every remaining element, moving them in ascending order to the
+     * given output iterator.
+     * @param out: the destination of the removed elements.
+     * @return the output iterator past the last element written.
+     */
+    template <typename OutputIterator>
+    OutputIterator drain ( OutputIterator out );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "kwaymerge.tpp"
+
+#endif // KWAYMERGE_H
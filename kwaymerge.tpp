@@ -0,0 +1,169 @@
+#include "kwaymerge.h"
+
+template <typename Comparable, typename Compare>
+KWayMerge<Comparable, Compare>::KWayMerge ( size_t batch, const Compare& compare )
+    : _batch { batch > 0 ? batch : 1 }, _playing { 0 }, _compare { compare } {}
+
+template <typename Comparable, typename Compare>
+bool KWayMerge<Comparable, Compare>::beats ( size_t a, size_t b )
+{
+    if ( _exhausted[a] | _exhausted[b] )
+        return !_exhausted[a];
+    return _compare ( _keys[a], _keys[b] );
+}
+
+template <typename Comparable, typename Compare>
+bool KWayMerge<Comparable, Compare>::next ( size_t source )
+{
+    if ( _current[source] == _end[source] )
+    {
+        size_t count = _exhausted[source] ? 0 : _sources[source] ( _batches[source].data(), _batch );
+        if ( count == 0 )
+        {
+            // Releases the source and its buffer for good.
+            _current[source] = _end[source] = nullptr;
+            _sources[source] = nullptr;
+            std::vector<Comparable>().swap ( _batches[source] );
+            _exhausted[source] = true;
+            return false;
+        }
+        _current[source] = _batches[source].data();
+        _end[source] = _current[source] + count;
+    }
+    _keys[source] = std::move ( *_current[source]++ );
+    return true;
+}
+
+template <typename Comparable, typename Compare>
+size_t KWayMerge<Comparable, Compare>::play ( size_t node )
+{
+    size_t k = _sources.size();
+    if ( node >= k )
+        return node - k;
+    size_t a = play ( 2 * node );
+    size_t b = play ( 2 * node + 1 );
+    if ( beats ( a, b ) )
+    {
+        _tree[node] = b;
+        return a;
+    }
+    _tree[node] = a;
+    return b;
+}
+
+template <typename Comparable, typename Compare>
+void KWayMerge<Comparable, Compare>::build ( )
+{
+    size_t k = _sources.size();
+    if ( _playing == k )
+        return;
+    _keys.resize ( k );
+    _exhausted.resize ( k, false );
+    for ( ; _playing < k; _playing++ )
+        next ( _playing );
+    _tree.resize ( k );
+    _tree[0] = play ( 1 );
+}
+
+template <typename Comparable, typename Compare>
+void KWayMerge<Comparable, Compare>::replaceWinner ( )
+{
+    size_t winner = _tree[0];
+    size_t k = _sources.size();
+    if ( next ( winner ) )
+    {
+        // The winner has an element, so only the loser may be exhausted.
+        // Which way a match goes is unpredictable: it is decided without
+        // branches.
+        for ( size_t node = ( winner + k ) / 2; node > 0; node /= 2 )
+        {
+            size_t loser = _tree[node];
+            bool wins = !_exhausted[loser] & _compare ( _keys[loser], _keys[winner] );
+            _tree[node] = wins ? winner : loser;
+            winner = wins ? loser : winner;
+        }
+    }
+    else
+    {
+        // The winner is exhausted: it loses to any source with an element.
+        for ( size_t node = ( winner + k ) / 2; node > 0; node /= 2 )
+        {
+            if ( beats ( _tree[node], winner ) )
+                std::swap ( _tree[node], winner );
+        }
+    }
+    _tree[0] = winner;
+}
+
+template <typename Comparable, typename Compare>
+template <typename Iterator>
+void KWayMerge<Comparable, Compare>::add ( Iterator first, Iterator last )
+{
+    add ( Generator ( [first, last] ( Comparable* batch, size_t capacity ) mutable
+    {
+        size_t count = 0;
+        for ( ; count < capacity && first != last; ++count, ++first )
+            batch[count] = *first;
+        return count;
+    } ) );
+}
+
+template <typename Comparable, typename Compare>
+void KWayMerge<Comparable, Compare>::add ( Generator generator )
+{
+    _sources.push_back ( std::move ( generator ) );
+    _batches.emplace_back ( _batch );
+    _current.push_back ( _batches.back().data() );
+    _end.push_back ( _batches.back().data() );
+}
+
+template <typename Comparable, typename Compare>
+size_t KWayMerge<Comparable, Compare>::sources() const
+{
+    return _sources.size();
+}
+
+template <typename Comparable, typename Compare>
+bool KWayMerge<Comparable, Compare>::empty()
+{
+    build();
+    return _sources.empty() || _exhausted[_tree[0]];
+}
+
+template <typename Comparable, typename Compare>
+const Comparable& KWayMerge<Comparable, Compare>::top ( )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _keys[_tree[0]];
+}
+
+template <typename Comparable, typename Compare>
+Comparable KWayMerge<Comparable, Compare>::pop ( )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _keys[_tree[0]] );
+    replaceWinner();
+    return min;
+}
+
+template <typename Comparable, typename Compare>
+template <typename OutputIterator>
+OutputIterator KWayMerge<Comparable, Compare>::pop_n ( size_t k, OutputIterator out )
+{
+    if ( empty() )
+        return out;
+    for ( ; k > 0 && !_exhausted[_tree[0]]; k-- )
+    {
+        *out = std::move ( _keys[_tree[0]] );
+        ++out;
+        replaceWinner();
+    }
+    return out;
+}
+
+template <typename Comparable, typename Compare>
+template <typename OutputIterator>
+OutputIterator KWayMerge<Comparable, Compare>::drain ( OutputIterator out )
+{
+    return pop_n ( SIZE_MAX, out );
+}
@@ -1,24 +1,58 @@
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
 #include "minimumheap.h"
+#include "addressableminimumheap.h"
+#include "keyedminimumheap.h"
+#include "multiqueue.h"
+#include "topkheap.h"
+#include "radixheap.h"
+#include "pairingheap.h"
+#include "mappedminimumheap.h"
+#include "externalminimumheap.h"
+#include "kwaymerge.h"
+#include "minmaxheap.h"
+#include "blockedminimumheap.h"
+#include "staticminimumheap.h"
+#include "flatcombiningheap.h"
+#include "tombstoneminimumheap.h"
+#if defined(__cpp_impl_coroutine)
+#include "asyncminimumheap.h"
+#endif
 
 using namespace std;
 
-template <typename Comparable>
-bool is_min_heap( const MinimumHeap<Comparable>& heap, size_t index = 0 )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+bool is_min_heap( const MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>& heap, size_t index = 0 )
 {
     if ( heap.size() == 0 ) return true;
     if ( index >= heap.size() ) return false;
 
-    size_t left = index*2+1;
-    size_t right = index*2+2;
-    if ( right < heap.size() )
-           return heap[index] <= heap[left] && heap[index] <= heap[right]
-                   && is_min_heap ( heap, left ) && is_min_heap ( heap, right );
-    else if ( left < heap.size() )
-           return heap[index] <= heap[left] && is_min_heap ( heap, left );
-    else
-        return true;
+    Compare compare;
+    for ( size_t child = index*Arity+1; child <= index*Arity+Arity && child < heap.size(); child++ )
+    {
+        if ( compare ( heap[child], heap[index] ) || !is_min_heap ( heap, child ) )
+            return false;
+    }
+    return true;
 }
 
 /**
@@ -357,9 +391,1743 @@ void test_double_stress ( void )
 
 }
 
+/**
+ * Int Test 13: creates minimum heaps of integers with wider arities by inserting
+ * and from a vector, verifies each passes the min heap test and pops in order.
+ */
+template <size_t Arity>
+void test_int_arity ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap " << Arity << "-ary Integer Stress:" << endl
+         << "**********************************************************************" << endl;
+
+    vector<int> vec;
+    for ( int i=1; i<=5000; i++)
+        vec.push_back(1 + std::rand()/((RAND_MAX + 1u)/10000));
+
+    MinimumHeap<int, Arity> inserted;
+    for ( size_t j=0; j<vec.size(); j++ )
+        inserted.insert(vec[j]);
+    MinimumHeap<int, Arity> constructed ( vec );
+
+    bool sorted = true;
+    int last = 0;
+    while ( !inserted.empty() )
+    {
+        int value = inserted.pop();
+        sorted = sorted && last <= value;
+        last = value;
+    }
+
+    cout << "\tmin heap (vector)?: " << ( is_min_heap(constructed, 0) ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( sorted ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 14: pops a large minimum heap of integers with the bottom-up pop
+ * strategy for binary and wider arities, verifying each remains a min heap and
+ * pops in order.
+ */
+template <size_t Arity>
+void test_int_bottom_up ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap " << Arity << "-ary Bottom-Up Pop:" << endl
+         << "**********************************************************************" << endl;
+
+    vector<int> vec;
+    for ( int i=1; i<=5000; i++)
+        vec.push_back(1 + std::rand()/((RAND_MAX + 1u)/10000));
+
+    MinimumHeap<int, Arity, MinimumHeapPop::BottomUp> heap ( vec );
+    bool valid = true;
+    bool sorted = true;
+    int last = 0;
+    while ( !heap.empty() )
+    {
+        int value = heap.pop();
+        sorted = sorted && last <= value;
+        valid = valid && is_min_heap(heap, 0);
+        last = value;
+    }
+
+    cout << "\tmin heap after each pop?: " << ( valid ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( sorted ? "true" : "false" ) << endl;
+}
+
+/**
+ * String Test 15: creates heap with the bottom-up pop strategy by inserting:
+ * "This", "is", "just" "a" "test". Output all the elements from the heap one at
+ * a time.
+ */
+void test_string_bottom_up ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap Bottom-Up Pop after insert" << endl
+         << "**********************************************************************" << endl
+         << "\tExpected: This a is just test" << endl
+         << "\t  Actual: ";
+
+    MinimumHeap<string, 2, MinimumHeapPop::BottomUp> heap;
+    heap.insert("This");
+    heap.insert("is");
+    heap.insert("just");
+    heap.insert("a");
+    heap.insert("test");
+    while ( !heap.empty() )
+    {
+        string s = heap.pop();
+        cout << s << " ";
+    }
+    cout << endl;
+}
+
+/**
+ * Int Test 16: creates an addressable minimum heap of integers, then decreases,
+ * increases and erases elements through their handles and verifies the
+ * remaining elements pop in order and that stale handles are detected.
+ */
+void test_int_addressable ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test AddressableMinHeap decrease_key / increase_key / erase:" << endl
+         << "**********************************************************************" << endl;
+
+    typedef AddressableMinimumHeap<int, 4> Heap;
+    Heap heap;
+    vector<Heap::Handle> handles;
+    vector<int> expected;
+    for ( int i=0; i<5000; i++ )
+    {
+        int value = 1 + std::rand()/((RAND_MAX + 1u)/10000);
+        handles.push_back ( heap.insert(value) );
+        expected.push_back ( value );
+    }
+
+    bool keys = true;
+    for ( size_t i=0; i<handles.size(); i+=3 )
+    {
+        expected[i] -= 5000;
+        heap.decrease_key ( handles[i], expected[i] );
+        keys = keys && heap.value ( handles[i] ) == expected[i];
+    }
+    for ( size_t i=1; i<handles.size(); i+=3 )
+    {
+        expected[i] += 5000;
+        heap.increase_key ( handles[i], expected[i] );
+    }
+    bool erased = true;
+    vector<int> remaining;
+    for ( size_t i=0; i<handles.size(); i++ )
+    {
+        if ( i % 6 == 2 )
+        {
+            erased = erased && heap.erase ( handles[i] ) == expected[i];
+            erased = erased && !heap.contains ( handles[i] );
+        }
+        else
+            remaining.push_back ( expected[i] );
+    }
+    expected = remaining;
+    sort ( expected.begin(), expected.end() );
+
+    bool sorted = heap.size() == expected.size();
+    for ( size_t i=0; sorted && i<expected.size(); i++ )
+        sorted = heap.pop() == expected[i];
+
+    bool stale = !heap.contains ( handles[0] );
+    try
+    {
+        heap.decrease_key ( handles[0], 0 );
+        stale = false;
+    }
+    catch ( MinimumHeapInvalidHandleException& ) {}
+
+    cout << "\tvalues updated?: " << ( keys ? "true" : "false" ) << endl
+         << "\terased?: " << ( erased ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( sorted ? "true" : "false" ) << endl
+         << "\tstale handle rejected?: " << ( stale ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 17: inserts batches of integers of increasing size into a minimum
+ * heap with insert_range, then removes them in batches with pop_n, verifying
+ * the heap remains a min heap and the elements are produced in order.
+ */
+void test_int_insert_range ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap insert_range / pop_n:" << endl
+         << "**********************************************************************" << endl;
+
+    MinimumHeap<int> heap;
+    list<int> input;
+    bool valid = true;
+    size_t total = 0;
+    for ( size_t batch=1; batch<=4096; batch*=4 )
+    {
+        vector<int> vec;
+        for ( size_t i=0; i<batch; i++ )
+            vec.push_back(1 + std::rand()/((RAND_MAX + 1u)/10000));
+        heap.insert_range( make_move_iterator(vec.begin()), make_move_iterator(vec.end()) );
+        input.assign( vec.begin(), vec.begin() + batch / 2 );
+        heap.insert_range( input.begin(), input.end() );
+        total += batch + batch / 2;
+        valid = valid && is_min_heap(heap, 0) && heap.size() == total;
+    }
+
+    vector<int> popped;
+    while ( heap.size() >= 100 )
+        heap.pop_n( 100, back_inserter(popped) );
+    heap.pop_n( heap.size(), back_inserter(popped) );
+
+    bool underflow = false;
+    try
+    {
+        heap.pop_n( 1, back_inserter(popped) );
+    }
+    catch ( MinimumHeapUnderflowException& )
+    {
+        underflow = true;
+    }
+
+    cout << "\tmin heap after each batch?: " << ( valid ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( is_sorted(popped.begin(), popped.end())
+                                       && popped.size() == total ? "true" : "false" ) << endl
+         << "\tunderflow detected?: " << ( underflow ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 18: creates a minimum heap of integers ordered by std::greater (so
+ * the largest element is at the top) and pops all of its elements.
+ */
+void test_int_compare ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap Pop with std::greater comparator:" << endl
+         << "**********************************************************************" << endl
+         << "\tExpected: 5 4 3 2 1" << endl
+         << "\t  Actual: ";
+
+    vector<int> vec {1, 2, 3, 4, 5};
+    MinimumHeap<int, 2, MinimumHeapPop::TopDown, greater<int>> heap (vec);
+    while ( !heap.empty() )
+        cout << heap.pop() << " ";
+    cout << endl;
+}
+
+/**
+ * A large record queued by its deadline, used by the keyed heap tests.
+ */
+struct Job
+{
+    unsigned long deadline;
+    string name;
+    char payload[192];
+};
+
+/**
+ * Projects the deadline of a Job as its key.
+ */
+struct JobDeadline
+{
+    unsigned long operator() ( const Job& job ) const { return job.deadline; }
+};
+
+/**
+ * A record counting the instances alive, moved-from ones included.
+ */
+struct Tracked
+{
+    static int alive;
+    int key = 0;
+    Tracked ( ) { alive++; }
+    explicit Tracked ( int k ) : key { k } { alive++; }
+    Tracked ( const Tracked& rhs ) : key { rhs.key } { alive++; }
+    Tracked& operator= ( const Tracked& rhs ) = default;
+    ~Tracked ( ) { alive--; }
+};
+int Tracked::alive = 0;
+
+/**
+ * Projects the key of a Tracked record.
+ */
+struct TrackedKey
+{
+    int operator() ( const Tracked& tracked ) const { return tracked.key; }
+};
+
+/**
+ * Record Test 19: creates a keyed minimum heap of jobs projected on their
+ * deadlines, interleaving inserts and pops, and verifies jobs pop in deadline
+ * order together with their payloads, and that no popped value is left alive
+ * in the heap.
+ */
+void test_job_keyed ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test KeyedMinHeap of Jobs by deadline:" << endl
+         << "**********************************************************************" << endl;
+
+    KeyedMinimumHeap<Job, JobDeadline> heap;
+    for ( int i=0; i<3000; i++ )
+    {
+        Job job;
+        job.deadline = 1 + std::rand()/((RAND_MAX + 1u)/10000);
+        job.name = "job " + std::to_string(job.deadline);
+        job.payload[0] = (char)job.deadline;
+        heap.insert( std::move(job) );
+        if ( i % 3 == 2 )
+            heap.pop();
+    }
+
+    bool sorted = true;
+    bool intact = true;
+    unsigned long last = 0;
+    while ( !heap.empty() )
+    {
+        unsigned long key = heap.top_key();
+        Job job = heap.pop();
+        sorted = sorted && last <= job.deadline && key == job.deadline;
+        intact = intact && job.name == "job " + std::to_string(job.deadline)
+                        && job.payload[0] == (char)job.deadline;
+        last = job.deadline;
+    }
+
+    KeyedMinimumHeap<Tracked, TrackedKey> tracked;
+    for ( int i=0; i<10; i++ )
+        tracked.insert( Tracked ( i ) );
+    tracked.pop();
+    Tracked popped;
+    tracked.pop( popped );
+    bool released = Tracked::alive == 9;
+    while ( !tracked.empty() )
+        tracked.pop();
+    released = released && Tracked::alive == 1;
+
+    cout << "\tpopped in order?: " << ( sorted ? "true" : "false" ) << endl
+         << "\tpayloads intact?: " << ( intact ? "true" : "false" ) << endl
+         << "\tpopped values released?: " << ( released ? "true" : "false" ) << endl;
+}
+
+/**
+ * Checks the vectorised smallest-key kernel for the given key type against a
+ * scalar search for every instruction set supported by the CPU.
+ */
+template <typename Key>
+bool simd_kernel_matches ( void )
+{
+    bool matches = true;
+    for ( int level = MinimumHeapSimd::Scalar; level <= MinimumHeapSimd::level(); level++ )
+    {
+        for ( size_t count = 1; count <= 40; count++ )
+        {
+            for ( int trial = 0; trial < 50; trial++ )
+            {
+                vector<Key> keys;
+                for ( size_t i = 0; i < count; i++ )
+                    keys.push_back( (Key)( std::rand() % 64 ) - (Key)32 );
+                size_t expected = min_element( keys.begin(), keys.end() ) - keys.begin();
+                size_t actual = MinimumHeapSimd::smallest( keys.data(), count,
+                                                           (MinimumHeapSimd::Level)level );
+                matches = matches && expected == actual;
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * Arithmetic Test 20: verifies the vectorised child selection kernels against a
+ * scalar search, then pops wide minimum heaps of int, long and double that use
+ * them, verifying they pop in order.
+ */
+void test_simd_child_select ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap SIMD child selection (level " << MinimumHeapSimd::level() << "):" << endl
+         << "**********************************************************************" << endl;
+
+    cout << "\tint32 kernel?: " << ( simd_kernel_matches<int32_t>() ? "true" : "false" ) << endl
+         << "\tint64 kernel?: " << ( simd_kernel_matches<int64_t>() ? "true" : "false" ) << endl
+         << "\tfloat kernel?: " << ( simd_kernel_matches<float>() ? "true" : "false" ) << endl
+         << "\tdouble kernel?: " << ( simd_kernel_matches<double>() ? "true" : "false" ) << endl;
+
+    vector<int> ints;
+    vector<long> longs;
+    vector<double> doubles;
+    for ( int i=0; i<5000; i++ )
+    {
+        int value = 1 + std::rand()/((RAND_MAX + 1u)/10000);
+        ints.push_back( value );
+        longs.push_back( value * 1000000000L );
+        doubles.push_back( value / 7.0 );
+    }
+    MinimumHeap<int, 16> intHeap ( ints );
+    MinimumHeap<long, 8> longHeap ( longs );
+    MinimumHeap<double, 8> doubleHeap ( doubles );
+    vector<int> poppedInts;
+    vector<long> poppedLongs;
+    vector<double> poppedDoubles;
+    intHeap.pop_n( intHeap.size(), back_inserter(poppedInts) );
+    longHeap.pop_n( longHeap.size(), back_inserter(poppedLongs) );
+    doubleHeap.pop_n( doubleHeap.size(), back_inserter(poppedDoubles) );
+
+    cout << "\tpopped in order?: "
+         << ( is_sorted(poppedInts.begin(), poppedInts.end())
+              && is_sorted(poppedLongs.begin(), poppedLongs.end())
+              && is_sorted(poppedDoubles.begin(), poppedDoubles.end()) ? "true" : "false" ) << endl;
+}
+
+/** An ordering of integers which throws on its next comparison once armed,
+ * shared by all its copies. **/
+struct ArmedLess
+{
+    shared_ptr<bool> armed = make_shared<bool>( false );
+    bool operator() ( int a, int b ) const
+    {
+        if ( *armed ) { *armed = false; throw runtime_error( "armed" ); }
+        return a < b;
+    }
+};
+
+/**
+ * Int Test 21: several threads concurrently insert distinct integers into a
+ * MultiQueue and pop from it; verifies every inserted integer is popped exactly
+ * once (none lost or duplicated), that a single-shard queue pops in order, and
+ * that a comparison throwing within insert leaves its shard unlocked.
+ */
+void test_int_multiqueue ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MultiQueue concurrent insert / pop:" << endl
+         << "**********************************************************************" << endl;
+
+    const int threads = 4;
+    const int perThread = 20000;
+    MultiQueue<int> queue ( threads );
+    vector<vector<int>> popped ( threads );
+    vector<thread> workers;
+    for ( int t=0; t<threads; t++ )
+    {
+        workers.push_back( thread( [&queue, &popped, t, perThread] ( )
+        {
+            int element;
+            for ( int i=0; i<perThread; i++ )
+            {
+                queue.insert( t * perThread + i );
+                if ( i % 2 == 1 && queue.try_pop( element ) )
+                    popped[t].push_back( element );
+            }
+        } ) );
+    }
+    for ( size_t t=0; t<workers.size(); t++ )
+        workers[t].join();
+
+    vector<int> all;
+    int element;
+    while ( queue.try_pop( element ) )
+        all.push_back( element );
+    for ( int t=0; t<threads; t++ )
+        all.insert( all.end(), popped[t].begin(), popped[t].end() );
+    sort( all.begin(), all.end() );
+    bool exact = all.size() == (size_t)( threads * perThread ) && queue.empty();
+    for ( size_t i=0; exact && i<all.size(); i++ )
+        exact = all[i] == (int)i;
+
+    // A queue left locked by the throw would spin forever on the next insert.
+    ArmedLess less;
+    MultiQueue<int, 2, ArmedLess> armed ( 1, 1, less );
+    armed.insert( 5 );
+    *less.armed = true;
+    bool unlocked = false;
+    try { armed.insert( 3 ); }
+    catch ( runtime_error& ) { unlocked = armed.size() == 1; }
+    armed.insert( 4 );
+    unlocked = unlocked && armed.size() == 2 && armed.pop() == 4 && armed.pop() == 5 && armed.empty();
+
+    MultiQueue<int> single ( 1, 1 );
+    for ( int i=5; i>0; i-- )
+        single.insert( i );
+    cout << "\tExpected (single shard): 1 2 3 4 5" << endl
+         << "\t  Actual (single shard): ";
+    while ( !single.empty() )
+        cout << single.pop() << " ";
+    cout << endl
+         << "\tnone lost or duplicated?: " << ( exact ? "true" : "false" ) << endl
+         << "\tshard unlocked after a throw?: " << ( unlocked ? "true" : "false" ) << endl;
+}
+
+/** An integer counting how many times it has been copy constructed or
+ * assigned. **/
+struct CopyCounted
+{
+    static int copies;
+    int value = 0;
+    CopyCounted ( ) = default;
+    explicit CopyCounted ( int v ) : value { v } {}
+    CopyCounted ( const CopyCounted& rhs ) : value { rhs.value } { copies++; }
+    CopyCounted ( CopyCounted&& rhs ) = default;
+    CopyCounted& operator= ( const CopyCounted& rhs ) { value = rhs.value; copies++; return *this; }
+    CopyCounted& operator= ( CopyCounted&& rhs ) = default;
+    bool operator< ( const CopyCounted& rhs ) const { return value < rhs.value; }
+};
+int CopyCounted::copies = 0;
+
+/**
+ * Int Test 22: streams random integers through a TopKHeap keeping the 100
+ * largest and verifies it keeps exactly the 100 largest without growing and
+ * copies only the elements it keeps, then checks replace_top and push_pop on
+ * a MinimumHeap.
+ */
+void test_int_top_k ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test TopKHeap / replace_top / push_pop:" << endl
+         << "**********************************************************************" << endl;
+
+    TopKHeap<int> best ( 100 );
+    vector<int> stream;
+    for ( int i=0; i<20000; i++ )
+    {
+        stream.push_back( std::rand() );
+        best.offer( stream.back() );
+    }
+    sort( stream.begin(), stream.end(), greater<int>() );
+    stream.resize( 100 );
+    vector<int> kept = best.take();
+
+    TopKHeap<CopyCounted> counted ( 10 );
+    CopyCounted::copies = 0;
+    int offersKept = 0;
+    for ( int i=0; i<1000; i++ )
+    {
+        const CopyCounted candidate ( i % 2 == 0 ? i : -i );
+        offersKept += counted.offer( candidate ) ? 1 : 0;
+    }
+    bool copiedKept = CopyCounted::copies == offersKept;
+
+    MinimumHeap<int> heap ( vector<int> {5, 4, 3, 2} );
+    size_t capacity = heap.capacity();
+    int rejected = heap.push_pop( 1 );
+    int replaced = heap.push_pop( 6 );
+    int top = heap.replace_top( 0 );
+
+    cout << "\tkept the 100 largest?: " << ( kept == stream ? "true" : "false" ) << endl
+         << "\tonly kept elements copied?: " << ( copiedKept ? "true" : "false" ) << endl
+         << "\tExpected: 1 2 3 0" << endl
+         << "\t  Actual: " << rejected << " " << replaced << " " << top << " " << heap.top() << endl
+         << "\tcapacity unchanged?: " << ( heap.capacity() == capacity ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 23: runs a small event simulation through a RadixHeap and a
+ * MinimumHeap side by side (pop the next event time, schedule a later one,
+ * peeking at the top in between) and verifies both pop the same times.
+ */
+void test_uint_radix ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test RadixHeap against MinimumHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    RadixHeap<unsigned long> radix;
+    MinimumHeap<unsigned long> heap;
+    for ( int i=0; i<1000; i++ )
+    {
+        unsigned long time = std::rand() % 100000;
+        radix.insert( time );
+        heap.insert( time );
+    }
+    bool same = true;
+    for ( int i=0; i<20000 && same; i++ )
+    {
+        same = radix.top() == heap.top();
+        unsigned long now = radix.pop();
+        same = same && now == heap.pop();
+        unsigned long later = now + std::rand() % ( i % 2 ? 10 : 100000 );
+        radix.insert( later );
+        heap.insert( later );
+        if ( i % 3 == 0 )
+        {
+            same = same && radix.top() == heap.top();
+            radix.insert( now );
+            heap.insert( now );
+        }
+    }
+    while ( same && !heap.empty() )
+        same = radix.pop() == heap.pop();
+
+    cout << "\tsame order?: " << ( same && radix.empty() ? "true" : "false" ) << endl;
+}
+
+/**
+ * A memory resource that counts the allocations made through it.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+private:
+    void* do_allocate ( size_t bytes, size_t alignment ) override
+    {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+    }
+    void do_deallocate ( void* p, size_t bytes, size_t alignment ) override
+    {
+        std::pmr::new_delete_resource()->deallocate( p, bytes, alignment );
+    }
+    bool do_is_equal ( const std::pmr::memory_resource& other ) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * String Test 24: fills and clears a PmrMinimumHeap of strings reserved in a
+ * counting memory resource and verifies that refilling it never allocates,
+ * then checks shrink_to_fit and the exact growth policy.
+ */
+void test_string_pmr ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test PmrMinimumHeap allocations:" << endl
+         << "**********************************************************************" << endl;
+
+    CountingResource resource;
+    PmrMinimumHeap<std::pmr::string> heap ( &resource );
+    heap.reserve( 64 );
+    size_t reserved = resource.allocations;
+
+    bool ordered = true;
+    for ( int round=0; round<3; round++ )
+    {
+        for ( int i=0; i<64; i++ )
+            heap.insert( std::pmr::string( 1, char( 'a' + std::rand() % 26 ) ) );
+        std::pmr::string last = heap.pop();
+        while ( !heap.empty() )
+        {
+            std::pmr::string next = heap.pop();
+            ordered = ordered && !( next < last );
+            last = next;
+        }
+        heap.clear();
+    }
+    bool steady = resource.allocations == reserved;
+    bool shared = heap.get_allocator().resource() == &resource;
+
+    heap.insert( "z" );
+    heap.shrink_to_fit();
+    bool shrunk = heap.capacity() == 1 && heap.top() == "z";
+
+    MinimumHeap<int, 2, MinimumHeapPop::TopDown, std::less<int>, std::allocator<int>,
+                MinimumHeapExactGrowth> exact ( 0 );
+    for ( int i=0; i<5; i++ )
+        exact.insert( i );
+
+    cout << "\tpopped in order?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tno allocation after reserve?: " << ( steady ? "true" : "false" ) << endl
+         << "\tallocator shared?: " << ( shared ? "true" : "false" ) << endl
+         << "\tshrunk to fit?: " << ( shrunk ? "true" : "false" ) << endl
+         << "\texact growth?: " << ( exact.capacity() == 5 ? "true" : "false" ) << endl;
+}
+
+/**
+ * A message with a priority which has no default constructor and counts how
+ * many times it is constructed (other than by moving).
+ */
+class Message
+{
+public:
+    static int constructed;
+    int priority;
+    string body;
+    Message ( int priority, const string& body ) : priority ( priority ), body ( body ) { constructed++; }
+    Message ( const Message& rhs ) : priority ( rhs.priority ), body ( rhs.body ) { constructed++; }
+    Message ( Message&& rhs ) = default;
+    Message& operator= ( const Message& rhs ) = default;
+    Message& operator= ( Message&& rhs ) = default;
+    bool operator< ( const Message& rhs ) const { return priority < rhs.priority; }
+};
+int Message::constructed = 0;
+
+/**
+ * Message Test 25: emplaces messages (which are not default constructible)
+ * into a MinimumHeap with spare capacity and verifies that each message is
+ * constructed exactly once and popped in order.
+ */
+void test_message_emplace ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap emplace:" << endl
+         << "**********************************************************************" << endl;
+
+    MinimumHeap<Message> heap ( 100 );
+    bool none = Message::constructed == 0;
+    for ( int i=0; i<50; i++ )
+        heap.emplace( std::rand() % 100, "message" );
+    heap.insert( Message( -1, "first" ) );
+    bool once = Message::constructed == 51;
+
+    bool ordered = heap.top().body == "first";
+    int last = -1;
+    while ( !heap.empty() )
+    {
+        Message next = heap.pop();
+        ordered = ordered && next.priority >= last;
+        last = next.priority;
+    }
+    bool capacity = heap.capacity() == 100;
+
+    cout << "\tno spare messages constructed?: " << ( none ? "true" : "false" ) << endl
+         << "\teach message constructed once?: " << ( once ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tcapacity unchanged?: " << ( capacity ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 26: merges MinimumHeaps and PairingHeaps of random sizes (so that
+ * both the sift up and the rebuild paths are taken) and verifies that the
+ * merged heaps hold every element, that the merged-in heaps are left empty,
+ * and that both pop the same elements in order.
+ */
+void test_int_merge ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap and PairingHeap merge:" << endl
+         << "**********************************************************************" << endl;
+
+    MinimumHeap<int> heap;
+    PairingHeap<int> pairing;
+    size_t total = 0;
+    bool valid = true;
+    bool emptied = true;
+    for ( int round=0; round<20; round++ )
+    {
+        MinimumHeap<int> other;
+        PairingHeap<int> otherPairing;
+        int count = round % 2 ? std::rand() % 10 : std::rand() % 1000;
+        for ( int i=0; i<count; i++ )
+        {
+            int value = std::rand() % 10000;
+            other.insert( value );
+            otherPairing.insert( value );
+        }
+        total += count;
+        heap.merge( std::move( other ) );
+        pairing.merge( std::move( otherPairing ) );
+        valid = valid && is_min_heap( heap ) && heap.size() == total && pairing.size() == total;
+        emptied = emptied && other.empty() && otherPairing.empty();
+    }
+
+    bool same = true;
+    int last = -1;
+    while ( !heap.empty() && same )
+    {
+        int next = heap.pop();
+        same = next == pairing.pop() && next >= last;
+        last = next;
+    }
+
+    cout << "\tmin heap after each merge?: " << ( valid ? "true" : "false" ) << endl
+         << "\tmerged heaps emptied?: " << ( emptied ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( same && pairing.empty() ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 27: inserts ascending and then descending keys into MinimumHeaps
+ * recording statistics and verifies the counts: ascending keys never sift
+ * up, descending keys sift up to the root, and each pop compares and moves.
+ * Also verifies that the default heap records nothing and is no larger.
+ */
+void test_int_stats ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap statistics:" << endl
+         << "**********************************************************************" << endl;
+
+    typedef MinimumHeap<int, 2, MinimumHeapPop::TopDown, std::less<int>, std::allocator<int>,
+                        MinimumHeapDoublingGrowth, MinimumHeapStats> CountedHeap;
+    CountedHeap ascending;
+    CountedHeap descending;
+    for ( int i=0; i<1024; i++ )
+    {
+        ascending.insert( i );
+        descending.insert( 1024 - i );
+    }
+    const MinimumHeapStats& up = ascending.stats();
+    const MinimumHeapStats& down = descending.stats();
+    bool sorted = up.siftUpDepths[0] == 1024 && up.comparisons == 1023;
+    bool reversed = down.siftUpDepths[0] == 1 && down.siftUpDepths[9] == 512
+                    && down.siftUpDepths[10] == 1;
+    bool grew = up.reallocations == 9 && up.peakSize == 1024;
+
+    uint64_t comparisons = up.comparisons;
+    uint64_t moves = up.moves;
+    ascending.pop();
+    bool popped = up.comparisons > comparisons && up.moves > moves && up.siftDownDepths[9] == 1;
+
+    cout << "\t";
+    ascending.stats().output();
+    cout << endl;
+
+    bool free = sizeof( MinimumHeap<int> ) == sizeof( std::vector<int> ) + sizeof( void* )
+                || MinimumHeapDefaultStats::enabled;
+
+    cout << "\tascending counted?: " << ( sorted ? "true" : "false" ) << endl
+         << "\tdescending counted?: " << ( reversed ? "true" : "false" ) << endl
+         << "\treallocations and peak counted?: " << ( grew ? "true" : "false" ) << endl
+         << "\tpop counted?: " << ( popped ? "true" : "false" ) << endl
+         << "\tdefault heap no larger?: " << ( free ? "true" : "false" ) << endl;
+}
+
 /**
  * Runs a series of tests on the template class MinimumHeap
  */
+/** A stream buffer over a string which cannot seek, like a pipe. **/
+class UnseekableBuffer : public streambuf
+{
+    string _data;
+public:
+    explicit UnseekableBuffer ( const string& data ) : _data { data }
+    {
+        setg( &_data[0], &_data[0], &_data[0] + _data.size() );
+    }
+};
+
+/**
+ * Int Test 28: saves a random MinimumHeap to a binary snapshot and verifies
+ * that loading it restores the same elements in the same order, that a
+ * corrupted or truncated snapshot, one with the same bits flipped in two
+ * words, one with a corrupt count (from a seekable
+ * and an unseekable stream) or one of another Arity is refused, and that a
+ * MappedMinimumHeap over the snapshot file pops the same sequence and can
+ * insert into the room left by its pops.
+ */
+void test_int_snapshot ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap snapshots:" << endl
+         << "**********************************************************************" << endl;
+
+    MinimumHeap<int> heap;
+    for ( int i=0; i<5000; i++ )
+        heap.insert( rand() % 100000 );
+
+    stringstream snapshot;
+    heap.save( snapshot );
+    string bytes = snapshot.str();
+    MinimumHeap<int> loaded = MinimumHeap<int>::load( snapshot );
+    bool same = loaded.size() == heap.size() && is_min_heap( loaded );
+    for ( size_t i=0; same && i<heap.size(); i++ )
+        same = loaded[i] == heap[i];
+
+    bool corrupt = false;
+    string damaged = bytes;
+    damaged[damaged.size() / 2] ^= 0x10;
+    stringstream corrupted ( damaged );
+    try { MinimumHeap<int>::load( corrupted ); }
+    catch ( MinimumHeapSnapshotException& ) { corrupt = true; }
+
+    // The same bits flipped in two words do not cancel out in the checksum.
+    bool paired = true;
+    for ( int bit : { 0, 31, 62, 63 } )
+    {
+        string flipped = bytes;
+        for ( size_t word : { 3, 100 } )
+        {
+            uint64_t value;
+            memcpy( &value, &flipped[sizeof( MinimumHeapSnapshotHeader ) + 8 * word], 8 );
+            value ^= uint64_t( 1 ) << bit;
+            memcpy( &flipped[sizeof( MinimumHeapSnapshotHeader ) + 8 * word], &value, 8 );
+        }
+        stringstream stream ( flipped );
+        try { MinimumHeap<int>::load( stream ); paired = false; }
+        catch ( MinimumHeapSnapshotException& ) { }
+    }
+
+    // A corrupt count or a truncated snapshot is refused without allocating
+    // the elements it claims, whether or not the stream can seek.
+    bool counted = true;
+    string huge = bytes;
+    uint64_t count = uint64_t( 1 ) << 40;
+    memcpy( &huge[offsetof( MinimumHeapSnapshotHeader, count )], &count, sizeof count );
+    for ( const string& broken : { huge, bytes.substr( 0, bytes.size() - 4 ) } )
+    {
+        bool seekable = false;
+        bool unseekable = false;
+        stringstream stream ( broken );
+        try { MinimumHeap<int>::load( stream ); }
+        catch ( MinimumHeapSnapshotException& ) { seekable = true; }
+        UnseekableBuffer buffer ( broken );
+        istream unseekableStream ( &buffer );
+        try { MinimumHeap<int>::load( unseekableStream ); }
+        catch ( MinimumHeapSnapshotException& ) { unseekable = true; }
+        counted = counted && seekable && unseekable;
+    }
+
+    bool arity = false;
+    stringstream other ( bytes );
+    try { MinimumHeap<int, 4>::load( other ); }
+    catch ( MinimumHeapSnapshotException& ) { arity = true; }
+
+    string path = ( filesystem::temp_directory_path() / "minimumheap_test.snapshot" ).string();
+    {
+        ofstream file ( path, ios::binary );
+        heap.save( file );
+    }
+    bool mapped = false;
+    bool refilled = false;
+    try
+    {
+        MappedMinimumHeap<int> map ( path );
+        mapped = map.size() == heap.size() && map.capacity() == heap.size();
+        MinimumHeap<int> copy = loaded;
+        for ( int i=0; mapped && i<100; i++ )
+            mapped = map.pop() == copy.pop();
+
+        bool full = false;
+        for ( int i=0; i<100; i++ )
+            map.insert( rand() % 100000 );
+        try { map.insert( 0 ); }
+        catch ( MinimumHeapOverflowException& ) { full = true; }
+        int last = map.pop();
+        refilled = full;
+        while ( refilled && !map.empty() )
+        {
+            int next = map.pop();
+            refilled = last <= next;
+            last = next;
+        }
+    }
+    catch ( MinimumHeapSnapshotException& ) { }
+    remove( path.c_str() );
+
+    cout << "\tloaded heap identical?: " << ( same ? "true" : "false" ) << endl
+         << "\tcorrupted snapshot refused?: " << ( corrupt ? "true" : "false" ) << endl
+         << "\tpaired bit flips refused?: " << ( paired ? "true" : "false" ) << endl
+         << "\tcorrupt count refused?: " << ( counted ? "true" : "false" ) << endl
+         << "\tother arity refused?: " << ( arity ? "true" : "false" ) << endl
+         << "\tmapped heap pops in order?: " << ( mapped ? "true" : "false" ) << endl
+         << "\tmapped heap refilled to capacity?: " << ( refilled ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 29: pushes twenty-five buffers' worth of random keys through an
+ * ExternalMinimumHeap with a small budget, interleaving pops, and verifies
+ * that every key pops in order and that the bytes written and read stay
+ * within twice the sorting bound: one pass to spill every key plus one pass
+ * per level of merges of fan-in k.
+ */
+void test_int_external ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test ExternalMinHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    ExternalMinimumHeap<int> heap ( 64 << 10, 4 << 10 );
+    std::multiset<int> expected;
+    const size_t count = heap.bufferCapacity() * 25;
+    bool ordered = true;
+    for ( size_t i=0; i<count; i++ )
+    {
+        int key = rand() % 1000000;
+        heap.insert( key );
+        expected.insert( key );
+        if ( i % 7 == 0 )
+        {
+            ordered = ordered && heap.top() == *expected.begin() && heap.pop() == *expected.begin();
+            expected.erase( expected.begin() );
+        }
+    }
+    bool spilled = heap.runs() > 0 && heap.runs() <= heap.fanIn();
+    size_t remaining = heap.size();
+    while ( ordered && !heap.empty() )
+    {
+        ordered = heap.pop() == *expected.begin();
+        expected.erase( expected.begin() );
+    }
+
+    double passes = std::ceil( std::log( (double) count / heap.bufferCapacity() ) / std::log( (double) heap.fanIn() ) );
+    double bound = 2 * ( 1 + passes ) * count * sizeof( int );
+    cout << "\tbytes written: " << heap.bytesWritten() << ", read: " << heap.bytesRead()
+         << ", sorting bound: " << ( 1 + passes ) * count * sizeof( int ) << endl;
+
+    cout << "\tspilled within the fan-in?: " << ( spilled ? "true" : "false" ) << endl
+         << "\tpopped in order?: " << ( ordered && remaining > 0 && heap.runs() == 0 ? "true" : "false" ) << endl
+         << "\tread back all written?: " << ( heap.bytesRead() == heap.bytesWritten() ? "true" : "false" ) << endl
+         << "\tclose to sorting bound?: " << ( heap.bytesWritten() <= bound ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 30: builds MinimumHeaps from a large random vector in parallel on
+ * several thread counts and arities and verifies the minimum property, then
+ * drains them sorted, sequentially and in parallel, and verifies the elements
+ * against std::sort, and that a parallel drain of a PmrMinimumHeap merges
+ * through a buffer from its memory resource.
+ */
+void test_int_parallel ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinHeap parallel build and sorted drain:" << endl
+         << "**********************************************************************" << endl;
+
+    vector<int> values ( 300000 );
+    for ( size_t i=0; i<values.size(); i++ )
+        values[i] = rand() % 100000;
+    vector<int> expected = values;
+    sort( expected.begin(), expected.end() );
+
+    bool built = true;
+    bool sorted = true;
+    for ( size_t threads : { 1, 2, 3, 8 } )
+    {
+        MinimumHeap<int> binary ( MinimumHeapParallel { threads }, values );
+        MinimumHeap<int, 4, MinimumHeapPop::BottomUp> quaternary ( MinimumHeapParallel { threads }, values );
+        built = built && is_min_heap( binary ) && binary.size() == values.size()
+                && is_min_heap( quaternary ) && quaternary.size() == values.size();
+        sorted = sorted && binary.sorted_drain( MinimumHeapParallel { threads } ) == expected
+                 && quaternary.sorted_drain( MinimumHeapParallel { threads } ) == expected
+                 && binary.empty();
+    }
+
+    MinimumHeap<int> heap ( values );
+    bool drained = heap.sorted_drain() == expected && heap.empty();
+    heap.insert( 3 );
+    drained = drained && heap.top() == 3;
+
+    // The merge buffer comes from the allocator of the heap.
+    CountingResource resource;
+    PmrMinimumHeap<int> pmr ( &resource );
+    pmr.insert_range( values.begin(), values.end() );
+    resource.allocations = 0;
+    std::pmr::vector<int> pmrSorted = pmr.sorted_drain( MinimumHeapParallel { 4 } );
+    bool buffered = resource.allocations > 0 && equal( pmrSorted.begin(), pmrSorted.end(),
+                                                       expected.begin(), expected.end() );
+
+    cout << "\tmin heap built in parallel?: " << ( built ? "true" : "false" ) << endl
+         << "\tdrained sorted in parallel?: " << ( sorted ? "true" : "false" ) << endl
+         << "\tdrained sorted sequentially?: " << ( drained ? "true" : "false" ) << endl
+         << "\tmerge buffer from the heap allocator?: " << ( buffered ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 31: merges sorted ranges (of random lengths, some empty) and a
+ * generator with a KWayMerge for several numbers of sources and verifies the
+ * output against std::sort, including sources of many equal keys.
+ */
+void test_int_kway_merge ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test KWayMerge:" << endl
+         << "**********************************************************************" << endl;
+
+    bool merged = true;
+    for ( size_t k : { 1, 2, 3, 8, 100 } )
+    {
+        vector<vector<int>> runs ( k );
+        vector<int> expected;
+        for ( size_t r=0; r<k; r++ )
+        {
+            runs[r].resize( rand() % 500 );
+            for ( size_t i=0; i<runs[r].size(); i++ )
+                runs[r][i] = rand() % 1000;
+            sort( runs[r].begin(), runs[r].end() );
+            expected.insert( expected.end(), runs[r].begin(), runs[r].end() );
+        }
+        KWayMerge<int> merge ( 16 );
+        for ( size_t r=0; r<k; r++ )
+            merge.add( runs[r].begin(), runs[r].end() );
+        int next = 0;
+        merge.add( [&next] ( int* batch, size_t capacity )
+        {
+            size_t count = 0;
+            for ( ; count < capacity && next < 1000; count++, next += 7 )
+                batch[count] = next;
+            return count;
+        } );
+        for ( int i=0; i<1000; i+=7 )
+            expected.push_back( i );
+        sort( expected.begin(), expected.end() );
+
+        vector<int> output;
+        if ( !merge.empty() )
+            output.push_back( merge.pop() );
+        merge.pop_n( 10, back_inserter( output ) );
+        merge.drain( back_inserter( output ) );
+        merged = merged && output == expected && merge.empty();
+    }
+
+    KWayMerge<int> duplicates ( 4 );
+    vector<vector<int>> same ( 5, vector<int> ( 50 ) );
+    for ( size_t r=0; r<same.size(); r++ )
+    {
+        for ( int i=0; i<50; i++ )
+            same[r][i] = i / 10;
+        duplicates.add( same[r].begin(), same[r].end() );
+    }
+    vector<int> output;
+    duplicates.drain( back_inserter( output ) );
+    bool ordered = output.size() == 250 && is_sorted( output.begin(), output.end() )
+                   && count( output.begin(), output.end(), 4 ) == 50;
+
+    bool underflow = false;
+    try { duplicates.pop(); }
+    catch ( MinimumHeapUnderflowException& ) { underflow = true; }
+
+    cout << "\tmerged in order?: " << ( merged ? "true" : "false" ) << endl
+         << "\tequal keys merged?: " << ( ordered ? "true" : "false" ) << endl
+         << "\texhausted merge underflows?: " << ( underflow ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 32: interleaves random inserts, pop_mins and pop_maxes on a
+ * MinMaxHeap built from a random vector and verifies each popped element and
+ * the min-max property against a std::multiset, then offers a random stream to
+ * a bounded MinMaxHeap and verifies that it keeps the smallest elements and
+ * evicts the others.
+ */
+void test_int_min_max ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test MinMaxHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    bool built = true;
+    bool popped = true;
+    for ( size_t n : { 0, 1, 2, 3, 7, 100, 1000 } )
+    {
+        vector<int> vec ( n );
+        for ( size_t i=0; i<n; i++ )
+            vec[i] = rand() % 500;
+        multiset<int> expected ( vec.begin(), vec.end() );
+        MinMaxHeap<int> heap ( std::move( vec ) );
+        built = built && heap.is_min_max_heap() && heap.size() == n;
+
+        for ( int op=0; op<3000; op++ )
+        {
+            int choice = rand() % 3;
+            if ( choice == 0 || expected.empty() )
+            {
+                int element = rand() % 500;
+                heap.insert( element );
+                expected.insert( element );
+            }
+            else if ( choice == 1 )
+            {
+                popped = popped && heap.top_min() == *expected.begin()
+                         && heap.pop_min() == *expected.begin();
+                expected.erase( expected.begin() );
+            }
+            else
+            {
+                popped = popped && heap.top_max() == *expected.rbegin()
+                         && heap.pop_max() == *expected.rbegin();
+                expected.erase( prev( expected.end() ) );
+            }
+            if ( op % 100 == 0 )
+                popped = popped && heap.is_min_max_heap() && heap.size() == expected.size();
+        }
+    }
+
+    MinMaxHeap<int> bounded ( 2, 50 );
+    vector<int> stream ( 2000 );
+    size_t evicted = 0;
+    for ( size_t i=0; i<stream.size(); i++ )
+    {
+        stream[i] = rand() % 10000;
+        if ( bounded.push_evict( stream[i] ) )
+            evicted++;
+    }
+    sort( stream.begin(), stream.end() );
+    vector<int> kept;
+    while ( !bounded.empty() )
+        kept.push_back( bounded.pop_min() );
+    bool evicts = evicted == stream.size() - 50 && kept.size() == 50
+                  && equal( kept.begin(), kept.end(), stream.begin() );
+
+    bool underflow = false;
+    try { bounded.pop_max(); }
+    catch ( MinimumHeapUnderflowException& ) { underflow = true; }
+
+    cout << "\tbuilt min-max heap?: " << ( built ? "true" : "false" ) << endl
+         << "\tpopped both ends in order?: " << ( popped ? "true" : "false" ) << endl
+         << "\tbounded keeps smallest?: " << ( evicts ? "true" : "false" ) << endl
+         << "\tempty heap underflows?: " << ( underflow ? "true" : "false" ) << endl;
+}
+
+/**
+ * Interleaves random inserts, pops and replace_tops on a BlockedMinimumHeap
+ * built from a random vector of n elements and verifies each popped element
+ * against a std::multiset.
+ */
+template <size_t BlockBytes, typename Allocator = std::allocator<int>>
+bool blocked_pops_in_order ( size_t n )
+{
+    vector<int> vec ( n );
+    for ( size_t i=0; i<n; i++ )
+        vec[i] = rand() % 100000;
+    multiset<int> expected ( vec.begin(), vec.end() );
+    BlockedMinimumHeap<int, BlockBytes, less<int>, Allocator> heap ( vec );
+    bool ordered = heap.size() == n;
+    for ( int op=0; op<5000; op++ )
+    {
+        int choice = rand() % 3;
+        int element = rand() % 100000;
+        if ( choice == 0 || expected.empty() )
+        {
+            heap.insert( element );
+            expected.insert( element );
+        }
+        else
+        {
+            int min = choice == 1 ? heap.pop() : heap.replace_top( element );
+            ordered = ordered && min == *expected.begin();
+            expected.erase( expected.begin() );
+            if ( choice == 2 )
+                expected.insert( element );
+        }
+    }
+    while ( !expected.empty() )
+    {
+        ordered = ordered && heap.top() == *expected.begin() && heap.pop() == *expected.begin();
+        expected.erase( expected.begin() );
+    }
+    return ordered && heap.empty();
+}
+
+/**
+ * Int Test 33: runs random operations on BlockedMinimumHeaps with blocks of
+ * a few elements (so that the heap spans many blocks), of a page, and backed
+ * by huge pages, verifying that they pop in order.
+ */
+void test_int_blocked ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test BlockedMinimumHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    bool small = true;
+    bool page = true;
+    for ( size_t n : { 0, 1, 2, 7, 100, 10000 } )
+    {
+        small = small && blocked_pops_in_order<16>( n ) && blocked_pops_in_order<64>( n );
+        page = page && blocked_pops_in_order<4096>( n );
+    }
+    bool huge = blocked_pops_in_order<4096, MinimumHeapHugePageAllocator<int>>( 1 << 20 );
+
+    BlockedMinimumHeap<int> empty;
+    bool underflow = false;
+    try { empty.pop(); }
+    catch ( MinimumHeapUnderflowException& ) { underflow = true; }
+
+    cout << "\tsmall blocks pop in order?: " << ( small ? "true" : "false" ) << endl
+         << "\tpage blocks pop in order?: " << ( page ? "true" : "false" ) << endl
+         << "\thuge pages pop in order?: " << ( huge ? "true" : "false" ) << endl
+         << "\tempty heap underflows?: " << ( underflow ? "true" : "false" ) << endl;
+}
+
+/**
+ * Produces the elements of a StaticMinimumHeap built from the given array in
+ * ascending order, by popping them (usable in constant expressions).
+ */
+template <size_t N, size_t Arity>
+constexpr array<int, N> static_heap_sort ( const array<int, N>& elements )
+{
+    StaticMinimumHeap<int, N, Arity> heap ( elements.begin(), elements.end() );
+    array<int, N> sorted {};
+    for ( size_t i=0; i<N; i++ )
+        sorted[i] = heap.pop();
+    return sorted;
+}
+
+/**
+ * Int Test 34: heapifies and sorts StaticMinimumHeaps during compilation
+ * (binary, and 16-ary so that the vectorised child selection is bypassed),
+ * then interleaves random inserts, pops and replace_tops on one at run time,
+ * verifying each popped element against a std::multiset, and verifies that
+ * inserting into a full heap is reported.
+ */
+void test_int_static ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test StaticMinimumHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    constexpr StaticMinimumHeap<int, 8> table { 5, 3, 8, 1 };
+    static_assert ( table.top() == 1 && table.size() == 4, "StaticMinimumHeap heapified at compile time" );
+    constexpr array<int, 6> binary = static_heap_sort<6, 2>( { 9, 4, 7, 1, 0, 3 } );
+    static_assert ( binary[0] == 0 && binary[3] == 4 && binary[5] == 9, "StaticMinimumHeap sorted at compile time" );
+    constexpr array<int, 20> wide = static_heap_sort<20, 16>( { 9, 4, 7, 1, 0, 3, 19, 18, 2, 5,
+                                                                6, 8, 10, 17, 11, 12, 16, 13, 15, 14 } );
+    static_assert ( wide[0] == 0 && wide[10] == 10 && wide[19] == 19, "StaticMinimumHeap sorted at compile time" );
+
+    StaticMinimumHeap<int, 64> heap;
+    multiset<int> expected;
+    bool ordered = true;
+    for ( int op=0; op<10000; op++ )
+    {
+        int choice = rand() % 3;
+        int element = rand() % 1000;
+        if ( choice == 0 && !heap.full() )
+        {
+            heap.insert( element );
+            expected.insert( element );
+        }
+        else if ( !expected.empty() )
+        {
+            int min = choice == 2 ? heap.replace_top( element ) : heap.pop();
+            ordered = ordered && min == *expected.begin();
+            expected.erase( expected.begin() );
+            if ( choice == 2 )
+                expected.insert( element );
+        }
+        ordered = ordered && heap.size() == expected.size();
+    }
+
+    StaticMinimumHeap<int, 4> full { 4, 3, 2, 1 };
+    bool overflow = false;
+    try { full.insert( 0 ); }
+    catch ( MinimumHeapOverflowException& ) { overflow = true; }
+    bool refused = !full.try_insert( 0 ) && full.size() == 4 && full.top() == 1;
+
+    cout << "\theapified at compile time?: true" << endl
+         << "\tpopped in order?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tfull heap overflows?: " << ( overflow ? "true" : "false" ) << endl
+         << "\tfull heap refuses try_insert?: " << ( refused ? "true" : "false" ) << endl;
+}
+
+#if defined(__cpp_impl_coroutine)
+typedef AsyncMinimumHeap<int, MinimumHeapManualExecutor> AsyncIntHeap;
+
+/** A consumer popping the given number of elements, logging each with its id. **/
+MinimumHeapDetachedTask async_consumer ( AsyncIntHeap& queue, int id, int count, vector<pair<int, int>>& log )
+{
+    for ( int i=0; i<count; i++ )
+        log.push_back( { id, co_await queue.pop() } );
+}
+
+/** A consumer popping one element within the given timeout, logging the
+ * element (or none) and the virtual time at which it got it. **/
+MinimumHeapDetachedTask async_timed_consumer ( AsyncIntHeap& queue, MinimumHeapManualExecutor& executor,
+                                               chrono::milliseconds timeout,
+                                               vector<pair<optional<int>, chrono::nanoseconds>>& log )
+{
+    optional<int> element = co_await queue.pop_for( timeout );
+    log.push_back( { element, executor.now() } );
+}
+#endif
+
+/**
+ * Int Test 35: suspends coroutine consumers on an empty AsyncMinimumHeap run
+ * by the deterministic MinimumHeapManualExecutor, verifying that they are
+ * resumed only by the executor, receive a batch of inserted elements in
+ * priority order, take available elements without suspending, and that
+ * pop_for times out at its deadline (on the virtual clock) unless an element
+ * arrives first, in which case its timer is cancelled. Reports that it was skipped where coroutines are unavailable
+ * (before C++20).
+ */
+void test_int_async ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test AsyncMinimumHeap:" << endl
+         << "**********************************************************************" << endl;
+#if defined(__cpp_impl_coroutine)
+    MinimumHeapManualExecutor executor;
+    AsyncIntHeap queue ( executor );
+
+    vector<pair<int, int>> log;
+    for ( int id=0; id<3; id++ )
+        async_consumer( queue, id, 1, log );
+    bool suspended = log.empty() && queue.waiting() == 3;
+    vector<int> batch { 30, 10, 20, 40 };
+    queue.insert_range( batch.begin(), batch.end() );
+    bool deferred = log.empty() && queue.waiting() == 0 && queue.size() == 1;
+    bool batched = executor.run() == 3;
+    bool ordered = log == vector<pair<int, int>> { { 0, 10 }, { 1, 20 }, { 2, 30 } };
+
+    log.clear();
+    queue.insert( 5 );
+    async_consumer( queue, 3, 2, log );
+    bool immediate = log == vector<pair<int, int>> { { 3, 5 }, { 3, 40 } } && queue.empty();
+
+    vector<pair<optional<int>, chrono::nanoseconds>> timed;
+    async_timed_consumer( queue, executor, chrono::milliseconds( 10 ), timed );
+    async_timed_consumer( queue, executor, chrono::milliseconds( 50 ), timed );
+    executor.advance( chrono::milliseconds( 20 ) );
+    bool expired = timed.size() == 1 && !timed[0].first && timed[0].second == chrono::milliseconds( 10 )
+                   && queue.waiting() == 1;
+    queue.insert( 7 );
+    executor.run();
+    bool disarmed = executor.idle();
+    executor.advance( chrono::milliseconds( 100 ) );
+    bool served = timed.size() == 2 && timed[1].first == 7 && timed[1].second == chrono::milliseconds( 20 )
+                  && executor.idle() && queue.waiting() == 0;
+    async_timed_consumer( queue, executor, chrono::milliseconds( 0 ), timed );
+    bool polled = timed.size() == 3 && !timed[2].first && !queue.try_pop();
+
+    cout << "\tconsumers suspended?: " << ( suspended ? "true" : "false" ) << endl
+         << "\tresumed by the executor only?: " << ( deferred ? "true" : "false" ) << endl
+         << "\twoken as one batch?: " << ( batched ? "true" : "false" ) << endl
+         << "\tserved in priority order?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tavailable elements taken at once?: " << ( immediate ? "true" : "false" ) << endl
+         << "\tpop_for times out at its deadline?: " << ( expired ? "true" : "false" ) << endl
+         << "\tpop_for served before its deadline?: " << ( served ? "true" : "false" ) << endl
+         << "\tpop_for timer cancelled once served?: " << ( disarmed ? "true" : "false" ) << endl
+         << "\tpop_for of 0 does not wait?: " << ( polled ? "true" : "false" ) << endl;
+#else
+    cout << "\tskipped (coroutines require C++20)" << endl;
+#endif
+}
+
+/** An element whose move construction throws for a negative value -n once it
+ * has been move constructed n times: -1 as the combiner of a FlatCombiningHeap
+ * moves it out of its slot, -2 as insert_range moves it into the heap. **/
+struct Fragile
+{
+    int value = 0;
+    int moves = 0;
+    Fragile ( ) = default;
+    explicit Fragile ( int v ) : value { v } {}
+    Fragile ( const Fragile& rhs ) = default;
+    Fragile ( Fragile&& rhs ) : value { rhs.value }, moves { rhs.moves + 1 }
+    {
+        if ( value < 0 && moves >= -value ) { throw runtime_error( "fragile" ); }
+    }
+    Fragile& operator= ( const Fragile& rhs ) = default;
+    Fragile& operator= ( Fragile&& rhs ) = default;
+    bool operator< ( const Fragile& rhs ) const { return value < rhs.value; }
+};
+
+/**
+ * Int Test 36: runs random inserts and pops of unique integers on a
+ * FlatCombiningHeap from several threads, timestamping each call and return
+ * on a shared clock, then verifies that no element was lost or duplicated and
+ * that the history is linearizable for a priority queue: no pop produced an
+ * element (or nothing) while a smaller element was certainly in the queue,
+ * i.e. inserted before the pop was called and not popped before it returned.
+ * Also runs the operations from a single thread against a std::multiset, and
+ * verifies that inserts whose element throws as the combiner moves it fail
+ * in their own threads while the others are served, and that an element
+ * throwing within insert_range leaves the heap unchanged.
+ */
+void test_int_flat_combining ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test FlatCombiningHeap linearizability:" << endl
+         << "**********************************************************************" << endl;
+
+    const int threads = 4;
+    const int perThread = 3000;
+    const uint64_t never = UINT64_MAX;
+    FlatCombiningHeap<int> queue ( threads );
+    atomic<uint64_t> clock { 0 };
+    struct Popped { int element; uint64_t called; uint64_t returned; };
+    vector<uint64_t> inserted ( threads * perThread, never );
+    vector<vector<Popped>> popped ( threads );
+    vector<thread> workers;
+    for ( int t=0; t<threads; t++ )
+    {
+        workers.push_back( thread( [&, t] ( )
+        {
+            mt19937 random ( t );
+            for ( int i=0; i<perThread; i++ )
+            {
+                uint64_t called = clock++;
+                if ( random() % 2 == 0 )
+                {
+                    int element = t * perThread + i;
+                    queue.insert( element );
+                    inserted[element] = clock++;
+                }
+                else
+                {
+                    int element = -1;
+                    if ( !queue.try_pop( element ) )
+                        element = -1;
+                    popped[t].push_back( { element, called, clock++ } );
+                }
+            }
+        } ) );
+    }
+    for ( size_t t=0; t<workers.size(); t++ )
+        workers[t].join();
+
+    vector<uint64_t> poppedAt ( threads * perThread, never );
+    bool exact = true;
+    for ( int t=0; t<threads; t++ )
+        for ( const Popped& pop : popped[t] )
+            if ( pop.element >= 0 )
+            {
+                exact = exact && inserted[pop.element] != never && poppedAt[pop.element] == never;
+                poppedAt[pop.element] = pop.called;
+            }
+    int element;
+    int previous = -1;
+    while ( queue.try_pop( element ) )
+    {
+        exact = exact && element > previous && inserted[element] != never && poppedAt[element] == never;
+        poppedAt[element] = never - 1;
+        previous = element;
+    }
+    for ( size_t u=0; u<inserted.size(); u++ )
+        exact = exact && ( inserted[u] == never ) == ( poppedAt[u] == never );
+
+    bool linearizable = true;
+    for ( int t=0; t<threads && linearizable; t++ )
+        for ( const Popped& pop : popped[t] )
+        {
+            size_t smaller = pop.element >= 0 ? (size_t) pop.element : inserted.size();
+            for ( size_t u=0; u<smaller && linearizable; u++ )
+                linearizable = !( inserted[u] < pop.called && poppedAt[u] > pop.returned );
+        }
+
+    FlatCombiningHeap<int> single ( 1 );
+    multiset<int> expected;
+    bool ordered = true;
+    for ( int op=0; op<10000; op++ )
+    {
+        if ( rand() % 2 == 0 )
+        {
+            int element = rand() % 1000;
+            single.insert( element );
+            expected.insert( element );
+        }
+        else if ( single.try_pop( element ) )
+        {
+            ordered = ordered && !expected.empty() && element == *expected.begin();
+            expected.erase( expected.begin() );
+        }
+        else
+            ordered = ordered && expected.empty();
+        ordered = ordered && single.size() == expected.size();
+    }
+
+    // Elements whose move throws in the combiner fail only their own insert,
+    // in their own thread, and the queue keeps serving the others.
+    FlatCombiningHeap<Fragile> fragile ( threads );
+    atomic<int> failures { 0 };
+    vector<vector<int>> taken ( threads );
+    workers.clear();
+    for ( int t=0; t<threads; t++ )
+    {
+        workers.push_back( thread( [&, t] ( )
+        {
+            Fragile element;
+            for ( int i=0; i<500; i++ )
+            {
+                try { fragile.insert( Fragile ( i % 50 == 49 ? -1 : t * 500 + i ) ); }
+                catch ( runtime_error& ) { failures++; }
+                if ( i % 2 == 0 && fragile.try_pop( element ) )
+                    taken[t].push_back( element.value );
+            }
+        } ) );
+    }
+    for ( size_t t=0; t<workers.size(); t++ )
+        workers[t].join();
+    vector<int> survivors;
+    Fragile survivor;
+    while ( fragile.try_pop( survivor ) )
+        survivors.push_back( survivor.value );
+    for ( int t=0; t<threads; t++ )
+        survivors.insert( survivors.end(), taken[t].begin(), taken[t].end() );
+    sort( survivors.begin(), survivors.end() );
+    bool isolated = failures == threads * 10 && survivors.size() == (size_t)( threads * 490 );
+    for ( size_t i=0; isolated && i<survivors.size(); i++ )
+        isolated = survivors[i] >= 0 && survivors[i] % 50 != 49 && ( i == 0 || survivors[i] > survivors[i - 1] );
+
+    // An element failing within insert_range leaves the heap as it was, with
+    // none of its range inserted, whether in a MinimumHeap or in a batch.
+    MinimumHeap<Fragile> heap;
+    vector<Fragile> range;
+    range.reserve( 10 );
+    for ( int i=0; i<10; i++ )
+    {
+        heap.insert( Fragile ( 100 - i ) );
+        range.push_back( Fragile ( i == 6 ? -2 : i ) );
+    }
+    bool rolledBack = false;
+    try { heap.insert_range( make_move_iterator( range.begin() ), make_move_iterator( range.end() ) ); }
+    catch ( runtime_error& ) { rolledBack = heap.size() == 10; }
+    for ( int i=91; rolledBack && i<=100; i++ )
+        rolledBack = heap.pop().value == i;
+    FlatCombiningHeap<Fragile> alone ( 1 );
+    alone.insert( Fragile ( 7 ) );
+    try { alone.insert( Fragile ( -2 ) ); rolledBack = false; }
+    catch ( runtime_error& ) { rolledBack = rolledBack && alone.size() == 1; }
+    rolledBack = rolledBack && alone.pop().value == 7 && alone.empty();
+
+    FlatCombiningHeap<int> empty ( 1 );
+    bool underflow = false;
+    try { empty.pop(); }
+    catch ( MinimumHeapUnderflowException& ) { underflow = true; }
+
+    cout << "\tnone lost or duplicated?: " << ( exact ? "true" : "false" ) << endl
+         << "\tlinearizable?: " << ( linearizable ? "true" : "false" ) << endl
+         << "\tsingle thread popped in order?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tfailed inserts rethrown, others served?: " << ( isolated ? "true" : "false" ) << endl
+         << "\tfailed insert_range rolled back?: " << ( rolledBack ? "true" : "false" ) << endl
+         << "\tempty queue underflows?: " << ( underflow ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 37: erases random fractions of the elements of MinimumHeaps with
+ * erase_if and verifies the minimum property and the remaining elements
+ * against a std::multiset, then runs random inserts, pops and cancellations
+ * on a TombstoneMinimumHeap, verifying each popped element, that cancelled
+ * and popped handles are refused, and that the tombstones never exceed the
+ * compaction threshold.
+ */
+void test_int_erase_if ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test erase_if / TombstoneMinimumHeap:" << endl
+         << "**********************************************************************" << endl;
+
+    bool erased = true;
+    for ( int modulus : { 1, 2, 10, 1000, 100000 } )
+    {
+        vector<int> elements;
+        for ( int i=0; i<20000; i++ )
+            elements.push_back( rand() % 100000 );
+        MinimumHeap<int, 4> heap ( elements );
+        size_t capacity = heap.capacity();
+        size_t count = heap.erase_if( [modulus] ( const int& element ) { return element % modulus == 0; } );
+        multiset<int> expected;
+        for ( int element : elements )
+            if ( element % modulus != 0 )
+                expected.insert( element );
+        erased = erased && count == elements.size() - expected.size() && heap.capacity() == capacity
+                 && is_min_heap( heap );
+        for ( int element : expected )
+            erased = erased && heap.pop() == element;
+    }
+    MinimumHeap<int> none ( vector<int> { 3, 1, 2 } );
+    bool kept = none.erase_if( [] ( const int& ) { return false; } ) == 0 && none.size() == 3;
+
+    TombstoneMinimumHeap<int> tombstones ( 0.25 );
+    typedef TombstoneMinimumHeap<int>::Handle Handle;
+    vector<pair<Handle, int>> handles;
+    multiset<int> expected;
+    bool ordered = true;
+    bool refused = true;
+    bool bounded = true;
+    for ( int op=0; op<20000; op++ )
+    {
+        int choice = rand() % 4;
+        if ( choice <= 1 || expected.empty() )
+        {
+            int element = rand() % 1000;
+            handles.push_back( { tombstones.insert( element ), element } );
+            expected.insert( element );
+        }
+        else if ( choice == 2 )
+        {
+            size_t index = rand() % handles.size();
+            bool live = tombstones.contains( handles[index].first );
+            bool deleted = tombstones.mark_deleted( handles[index].first );
+            refused = refused && live == deleted && !tombstones.mark_deleted( handles[index].first );
+            if ( deleted )
+                expected.erase( expected.find( handles[index].second ) );
+        }
+        else
+        {
+            ordered = ordered && tombstones.top() == *expected.begin() && tombstones.pop() == *expected.begin();
+            expected.erase( expected.begin() );
+        }
+        ordered = ordered && tombstones.size() == expected.size();
+        bounded = bounded && tombstones.tombstones() <= 0.25 * ( tombstones.size() + tombstones.tombstones() ) + 1;
+    }
+    size_t cancelled = tombstones.erase_if( [] ( const int& element ) { return element < 500; } );
+    size_t below = distance( expected.begin(), expected.lower_bound( 500 ) );
+    expected.erase( expected.begin(), expected.lower_bound( 500 ) );
+    ordered = ordered && cancelled == below && tombstones.tombstones() == 0;
+    for ( int element : expected )
+        ordered = ordered && tombstones.pop() == element;
+    ordered = ordered && tombstones.empty();
+
+    cout << "\terase_if kept the others in a heap?: " << ( erased ? "true" : "false" ) << endl
+         << "\terase_if of nothing changes nothing?: " << ( kept ? "true" : "false" ) << endl
+         << "\ttombstones skipped?: " << ( ordered ? "true" : "false" ) << endl
+         << "\tstale handles refused?: " << ( refused ? "true" : "false" ) << endl
+         << "\ttombstones within the threshold?: " << ( bounded ? "true" : "false" ) << endl;
+}
+
+/**
+ * Int Test 38: iterates over random MinimumHeaps in ascending order with
+ * sorted(), through standard algorithms (and ranges, where available),
+ * verifying the elements against std::sort and that the heap is unchanged,
+ * then drains the smallest elements of a heap with drain_sorted(), verifying
+ * them and that the heap keeps the rest, and drains a heap of strings by
+ * moving its elements out.
+ */
+void test_int_sorted_range ( void )
+{
+    cout << "**********************************************************************" << endl
+         << "Test sorted / drain_sorted:" << endl
+         << "**********************************************************************" << endl;
+
+    vector<int> elements;
+    for ( int i=0; i<10000; i++ )
+        elements.push_back( rand() % 5000 );
+    vector<int> expected = elements;
+    sort( expected.begin(), expected.end() );
+
+    MinimumHeap<int> binary ( elements );
+    MinimumHeap<int, 4> quaternary ( elements );
+    MinimumHeap<int> before = binary;
+    auto range = binary.sorted();
+    bool sorted = vector<int>( range.begin(), range.end() ) == expected
+                  && vector<int>( quaternary.sorted().begin(), quaternary.sorted().end() ) == expected
+                  && is_sorted( range.begin(), range.end() ) && range.size() == expected.size();
+    vector<int> first ( 10 );
+    copy_n( range.begin(), 10, first.begin() );
+    sorted = sorted && equal( first.begin(), first.end(), expected.begin() );
+    bool unchanged = binary.size() == before.size();
+    for ( size_t i=0; unchanged && i<binary.size(); i++ )
+        unchanged = binary[i] == before[i];
+    MinimumHeap<int> empty;
+    sorted = sorted && empty.sorted().begin() == empty.sorted().end();
+#if defined(__cpp_lib_ranges)
+    static_assert ( std::ranges::forward_range<decltype( range )> && std::ranges::view<decltype( range )>,
+                    "sorted() is a forward view" );
+    static_assert ( std::ranges::input_range<decltype( binary.drain_sorted() )>, "drain_sorted() is an input range" );
+    auto least = binary.sorted() | std::views::take( 5 );
+    sorted = sorted && std::ranges::equal( least, vector<int>( expected.begin(), expected.begin() + 5 ) );
+#endif
+
+    bool drained = true;
+    {
+        auto drain = binary.drain_sorted();
+        auto it = drain.begin();
+        for ( int i=0; i<100; i++, ++it )
+            drained = drained && *it == expected[i];
+        drained = drained && drain.size() == expected.size() - 100;
+    }
+    drained = drained && binary.size() == expected.size() - 100 && is_min_heap( binary )
+              && binary.sorted_drain() == vector<int>( expected.begin() + 100, expected.end() );
+    vector<int> all;
+    for ( int element : quaternary.drain_sorted() )
+        all.push_back( element );
+    drained = drained && all == expected && quaternary.empty();
+
+    MinimumHeap<string> words ( vector<string> { "pear", "apple", "fig", "kiwi" } );
+    vector<string> moved;
+    for ( string& word : words.drain_sorted() )
+        moved.push_back( std::move( word ) );
+
+    cout << "\tsorted() in order?: " << ( sorted ? "true" : "false" ) << endl
+         << "\theap unchanged?: " << ( unchanged ? "true" : "false" ) << endl
+         << "\tdrained the smallest, kept the rest?: " << ( drained ? "true" : "false" ) << endl
+         << "\tExpected: apple fig kiwi pear" << endl
+         << "\t  Actual: ";
+    for ( const string& word : moved )
+        cout << word << " ";
+    cout << endl;
+}
+
 int main ( void )
 {
     srand(time(nullptr));
@@ -376,5 +2144,33 @@ int main ( void )
     test_string_pop_from_insert( );
     test_int_stress( );
     test_double_stress( );
+    test_int_arity<4>( );
+    test_int_arity<8>( );
+    test_int_bottom_up<2>( );
+    test_int_bottom_up<4>( );
+    test_string_bottom_up( );
+    test_int_addressable( );
+    test_int_insert_range( );
+    test_int_compare( );
+    test_job_keyed( );
+    test_simd_child_select( );
+    test_int_multiqueue( );
+    test_int_top_k( );
+    test_uint_radix( );
+    test_string_pmr( );
+    test_message_emplace( );
+    test_int_merge( );
+    test_int_stats( );
+    test_int_snapshot( );
+    test_int_external( );
+    test_int_parallel( );
+    test_int_kway_merge( );
+    test_int_min_max( );
+    test_int_blocked( );
+    test_int_static( );
+    test_int_async( );
+    test_int_flat_combining( );
+    test_int_erase_if( );
+    test_int_sorted_range( );
     return 0;
 }
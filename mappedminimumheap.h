@@ -0,0 +1,199 @@
+#ifndef MAPPEDMINIMUMHEAP_H
+#define MAPPEDMINIMUMHEAP_H
+
+#include <functional>
+#include <ostream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include "minimumheap.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * A minimum heap used in place in a memory mapping of a binary snapshot file
+ * written by MinimumHeap::save, for restarting with a large heap without
+ * reading or re-heapifying it first: opening the heap maps the file, and only
+ * the pages a pop or insert touches are ever read from it (unless the
+ * checksum is verified, which reads the whole file once).
+ *
+ * The mapping is private (copy on write): the heap may be modified, but the
+ * changes are never written back to the file, and the pages modified are
+ * copied into memory as they are touched. The capacity of the heap is fixed to
+ * the number of elements in the snapshot, so elements can be inserted only
+ * into the room left by earlier pops; to grow beyond it, load the snapshot
+ * into a MinimumHeap instead (MinimumHeap::load).
+ *
+ * The Arity and element size must match the snapshot, and Compare must order
+ * the elements as the saved heap did. Requires a trivially copyable
+ * Comparable and a POSIX system (mmap).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          MinimumHeapPop Pop = MinimumHeapPop::TopDown,
+          typename Compare = std::less<Comparable>> class MappedMinimumHeap {
+
+    static_assert ( std::is_trivially_copyable<Comparable>::value,
+                    "MappedMinimumHeap requires a trivially copyable Comparable." );
+
+private:
+
+    /** The mapping of the snapshot file. **/
+    void* _mapping;
+
+    /** The length of the mapping in bytes. **/
+    size_t _length;
+
+    /** The elements of the heap, just past the header in the mapping. **/
+    Comparable* _elements;
+
+    /** The current size of the MappedMinimumHeap. **/
+    size_t _size;
+
+    /** The number of elements in the snapshot. **/
+    size_t _capacity;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /** The sift engine for the Arity of the heap. **/
+    typedef MinimumHeapSift<Arity> Sift;
+
+    /**
+     * Unmaps the snapshot, if mapped.
+     */
+    void unmap ( );
+
+public:
+
+    /**
+     * Instantiate a MappedMinimumHeap by mapping the given snapshot file.
+     * @param path: the path of the snapshot file.
+     * @param verify: whether to verify the checksum (default = true), which
+     * reads the whole file once.
+     * @param compare: the function object used to order the elements.
+     * @throws MinimumHeapSnapshotException if the file cannot be mapped, or
+     * its header does not match the heap, or the checksum does not match
+     */
+    explicit MappedMinimumHeap ( const std::string& path, bool verify = true,
+                                 const Compare& compare = Compare() );
+
+    MappedMinimumHeap ( const MappedMinimumHeap& rhs ) = delete;
+    MappedMinimumHeap& operator= ( const MappedMinimumHeap& rhs ) = delete;
+
+    /**
+     * Instantiate a MappedMinimumHeap by taking the mapping of an existing
+     * temporary MappedMinimumHeap, which is left empty.
+     * (Move Constructor)
+     * @param rhs: the MappedMinimumHeap to take the mapping from.
+    **/
+    MappedMinimumHeap ( MappedMinimumHeap&& rhs );
+
+    /**
+     * Takes the mapping of an assigned temporary MappedMinimumHeap, which is
+     * left empty, unmapping the one held before.
+     * (Move Assignment Constructor)
+     * @param rhs: the MappedMinimumHeap to take the mapping from.
+    **/
+    MappedMinimumHeap& operator= ( MappedMinimumHeap&& rhs );
+
+    /**
+     * Destructor: unmaps the snapshot, discarding any changes.
+    **/
+    ~MappedMinimumHeap ( );
+
+    /**
+     * Produces the current size of the MappedMinimumHeap.
+     * @return number of elements in the MappedMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Produces the number of elements the MappedMinimumHeap can hold: the
+     * number of elements in the snapshot.
+     * @return the capacity of the MappedMinimumHeap.
+     */
+    size_t capacity() const;
+
+    /**
+     * Determines if the MappedMinimumHeap is empty (it contains no elements).
+     * @return true if the MappedMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the MappedMinimumHeap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Produces the element in the heap at the given index position, indexed
+     * as in MinimumHeap::at.
+     * @param index: the index of the element to return.
+     * @return the value of the element at the given index.
+     * @throws MinimumHeapIndexOutOfBoundsException if the index is not within
+     * the bounds [0, size).
+     */
+    const Comparable& at ( size_t index ) const;
+
+    /**
+     * Produces the element in the heap at the given index position, indexed
+     * as in MinimumHeap::at.
+     * @param index: the index of the element to return.
+     * @return the value of the element at the given index.
+     * @throws MinimumHeapIndexOutOfBoundsException if the index is not within
+     * the bounds [0, size).
+     */
+    const Comparable& operator[] ( size_t index ) const;
+
+    /**
+     * Inserts the given element into the heap at the appropriate position
+     * such that the minimum property of the heap is preserved.
+     * @param element: the element to be inserted into the heap
+     * @throws MinimumHeapOverflowException if the heap is at its capacity
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap preserving the minimum property
+     * of the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the MappedMinimumHeap is empty
+     */
+    Comparable pop ();
+
+    /**
+     * Removes the element at the top of the heap and inserts the given
+     * element in its place with a single sift down (see
+     * MinimumHeap::replace_top).
+     * @param element: the element to be inserted into the heap
+     * @return the value of the smallest element before the replacement.
+     * @throws MinimumHeapUnderflowException if the MappedMinimumHeap is empty
+     */
+    Comparable replace_top ( const Comparable& element );
+
+    /**
+     * Writes a binary snapshot of the heap, as it is now, to the given stream
+     * (see MinimumHeap::save).
+     * @param out: the (binary) output stream to be written to.
+     * @throws MinimumHeapSnapshotException if the stream fails
+     */
+    void save ( std::ostream& out ) const;
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "mappedminimumheap.tpp"
+
+#endif // MAPPEDMINIMUMHEAP_H
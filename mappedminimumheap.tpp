@@ -0,0 +1,175 @@
+#include "mappedminimumheap.h"
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void MappedMinimumHeap<Comparable, Arity, Pop, Compare>::unmap ( )
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if ( _mapping != nullptr )
+        munmap ( _mapping, _length );
+#endif
+    _mapping = nullptr;
+    _elements = nullptr;
+    _length = 0;
+    _size = 0;
+    _capacity = 0;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+MappedMinimumHeap<Comparable, Arity, Pop, Compare>::MappedMinimumHeap ( const std::string& path, bool verify,
+                                                       const Compare& compare )
+    : _mapping { nullptr }, _length { 0 }, _elements { nullptr }, _size { 0 },
+      _capacity { 0 }, _compare { compare }
+{
+#if defined(__unix__) || defined(__APPLE__)
+    int file = open ( path.c_str(), O_RDONLY );
+    if ( file < 0 ) { throw MinimumHeapSnapshotException(); }
+    struct stat status;
+    if ( fstat ( file, &status ) != 0 || status.st_size < (off_t) sizeof ( MinimumHeapSnapshotHeader ) )
+    {
+        close ( file );
+        throw MinimumHeapSnapshotException();
+    }
+    _length = static_cast<size_t> ( status.st_size );
+    void* mapping = mmap ( nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+    close ( file );
+    if ( mapping == MAP_FAILED ) { throw MinimumHeapSnapshotException(); }
+    _mapping = mapping;
+
+    const MinimumHeapSnapshotHeader* header = static_cast<const MinimumHeapSnapshotHeader*> ( _mapping );
+    size_t room = ( _length - sizeof ( MinimumHeapSnapshotHeader ) ) / sizeof ( Comparable );
+    if ( !header->matches ( Arity, sizeof ( Comparable ) ) || header->count > room )
+    {
+        unmap();
+        throw MinimumHeapSnapshotException();
+    }
+    _elements = reinterpret_cast<Comparable*> ( static_cast<char*> ( _mapping ) + sizeof ( MinimumHeapSnapshotHeader ) );
+    _size = _capacity = header->count;
+    if ( verify && MinimumHeapSnapshotHeader::hash ( _elements, _size * sizeof ( Comparable ) ) != header->checksum )
+    {
+        unmap();
+        throw MinimumHeapSnapshotException();
+    }
+#else
+    (void) path;
+    (void) verify;
+    throw MinimumHeapSnapshotException();
+#endif
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+MappedMinimumHeap<Comparable, Arity, Pop, Compare>::MappedMinimumHeap ( MappedMinimumHeap&& rhs )
+    : _mapping { rhs._mapping }, _length { rhs._length }, _elements { rhs._elements },
+      _size { rhs._size }, _capacity { rhs._capacity }, _compare { rhs._compare }
+{
+    rhs._mapping = nullptr;
+    rhs.unmap();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+MappedMinimumHeap<Comparable, Arity, Pop, Compare>& MappedMinimumHeap<Comparable, Arity, Pop, Compare>::operator= ( MappedMinimumHeap&& rhs )
+{
+    if ( &rhs != this )
+    {
+        unmap();
+        _mapping = rhs._mapping;
+        _length = rhs._length;
+        _elements = rhs._elements;
+        _size = rhs._size;
+        _capacity = rhs._capacity;
+        _compare = rhs._compare;
+        rhs._mapping = nullptr;
+        rhs.unmap();
+    }
+    return *this;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+MappedMinimumHeap<Comparable, Arity, Pop, Compare>::~MappedMinimumHeap ( )
+{
+    unmap();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t MappedMinimumHeap<Comparable, Arity, Pop, Compare>::size() const
+{
+    return _size;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t MappedMinimumHeap<Comparable, Arity, Pop, Compare>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool MappedMinimumHeap<Comparable, Arity, Pop, Compare>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& MappedMinimumHeap<Comparable, Arity, Pop, Compare>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _elements[0];
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& MappedMinimumHeap<Comparable, Arity, Pop, Compare>::at ( size_t index ) const
+{
+    if ( index >= _size ) { throw MinimumHeapIndexOutOfBoundsException(); }
+    return _elements[index];
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& MappedMinimumHeap<Comparable, Arity, Pop, Compare>::operator[] ( size_t index ) const
+{
+    return at ( index );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void MappedMinimumHeap<Comparable, Arity, Pop, Compare>::insert ( const Comparable& element )
+{
+    if ( _size == _capacity ) { throw MinimumHeapOverflowException(); }
+    MinimumHeapIgnorePlacement placed;
+    Comparable value = element;
+    Sift::siftUp ( _elements, 0, _size, std::move ( value ), _compare, placed );
+    _size++;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable MappedMinimumHeap<Comparable, Arity, Pop, Compare>::pop ()
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = _elements[0];
+    _size--;
+    if ( _size > 0 )
+    {
+        MinimumHeapIgnorePlacement placed;
+        Comparable last = _elements[_size];
+        Sift::template fillHole<Pop> ( _elements, _size, 0, std::move ( last ), _compare, placed );
+    }
+    return min;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable MappedMinimumHeap<Comparable, Arity, Pop, Compare>::replace_top ( const Comparable& element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    MinimumHeapIgnorePlacement placed;
+    Comparable min = _elements[0];
+    Comparable value = element;
+    Sift::siftDown ( _elements, _size, 0, std::move ( value ), _compare, placed );
+    return min;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void MappedMinimumHeap<Comparable, Arity, Pop, Compare>::save ( std::ostream& out ) const
+{
+    MinimumHeapSnapshotHeader header = MinimumHeapSnapshotHeader::make (
+            Arity, sizeof ( Comparable ), _elements, _size );
+    out.write ( reinterpret_cast<const char*> ( &header ), sizeof header );
+    out.write ( reinterpret_cast<const char*> ( _elements ),
+                static_cast<std::streamsize> ( _size * sizeof ( Comparable ) ) );
+    if ( !out ) { throw MinimumHeapSnapshotException(); }
+}
@@ -1,11 +1,22 @@
 #ifndef MINIMUMHEAP_H
 #define MINIMUMHEAP_H
 
+#include <algorithm>
 #include <vector>
 #include <ostream>
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <memory_resource>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include "minimumheapsift.h"
+#include "minimumheapparallel.h"
+#include "minimumheapstats.h"
+#include "minimumheapsnapshot.h"
+#include "minimumheapsorted.h"
 
 /**
  * @brief Exception: An operation has been attempted on an empty MinimumHeap.
@@ -17,47 +28,154 @@ class MinimumHeapUnderflowException {};
  */
 class MinimumHeapIndexOutOfBoundsException {};
 
+/**
+ * @brief Exception: An element has been inserted into a full heap of fixed capacity.
+ */
+class MinimumHeapOverflowException {};
+
+/**
+ * The Arity for which the children of an element in a MinimumHeap of the given
+ * element type fill one 64-byte cache line (e.g. 8 for 8-byte keys, 4 for
+ * 16-byte keys), clamped to at least 2.
+ */
+template <typename Comparable>
+constexpr size_t MinimumHeapCacheLineArity =
+        64 / sizeof(Comparable) >= 2 ? 64 / sizeof(Comparable) : 2;
+
+/**
+ * Growth policy of a MinimumHeap: the capacity grows geometrically, being
+ * multiplied by Numerator / Denominator (at least by one element) until the
+ * required number of elements fits, starting from a capacity of at least 2.
+ */
+template <size_t Numerator, size_t Denominator = 1>
+struct MinimumHeapGeometricGrowth {
+
+    static_assert ( Numerator > Denominator && Denominator > 0,
+                    "MinimumHeapGeometricGrowth requires a factor greater than 1." );
+
+    /**
+     * Produces the new capacity for a heap that must hold the given number
+     * of elements.
+     * @param capacity: the current capacity.
+     * @param required: the number of elements that must fit (> capacity).
+     * @return the new capacity, at least required.
+     */
+    static size_t next ( size_t capacity, size_t required )
+    {
+        size_t grown = capacity < 2 ? 2 : capacity;
+        while ( grown < required )
+            grown = std::max ( grown + 1, grown / Denominator * Numerator );
+        return grown;
+    }
+};
+
+/** The default growth policy of a MinimumHeap: the capacity doubles. **/
+typedef MinimumHeapGeometricGrowth<2> MinimumHeapDoublingGrowth;
+
+/**
+ * Growth policy of a MinimumHeap: the capacity grows to exactly the number of
+ * elements required. Suits heaps whose final size is reserved up front, or
+ * whose memory comes from an arena that cannot reuse freed blocks.
+ */
+struct MinimumHeapExactGrowth {
+
+    static size_t next ( size_t capacity, size_t required )
+    {
+        return std::max ( capacity, required );
+    }
+};
+
 /**
  * A minimum heap of Comparable elements. The MinimumHeap is a balanced tree
  * structure such that each element of the MinimumHeap must be less than than
  * any of its descendant elements.
  *
- * The root element in the heap is indexed at position 0. Subsequent elements are
- * indexed such that the the index of a left element is 2 * parent index + 1 and
- * the index of the right element is 2 * parent index + 2.
+ * The root element in the heap is indexed at position 0. Each element has up to
+ * Arity children (default = 2, a binary heap) which are stored contiguously:
+ * the children of the element at index i are indexed from Arity * i + 1 to
+ * Arity * i + Arity. For a binary heap the index of a left element is therefore
+ * 2 * parent index + 1 and the index of the right element is 2 * parent index + 2.
+ *
+ * A wider heap is shallower (log_Arity(n) levels rather than log_2(n)) so pop()
+ * visits fewer levels, at the cost of comparing more children per level. Since
+ * siblings are contiguous, the children of an element occupy
+ * Arity * sizeof(Comparable) bytes; choosing the Arity such that this is one
+ * cache line (see MinimumHeapCacheLineArity) means each level of a sift touches
+ * a single line of children.
+ *
+ * Elements are sifted by moving a hole rather than by swapping, so each element
+ * passed over during insert or pop is moved once. The Pop strategy selects how
+ * the hole left by pop() is refilled (see MinimumHeapPop): TopDown (default)
+ * sifts the last element down from the root, while BottomUp sinks the hole to
+ * a leaf first and sifts the last element back up, which needs fewer
+ * comparisons when the less than operator is expensive.
+ *
+ * Elements are ordered by the Compare function object (default =
+ * std::less<Comparable>, i.e. the less than operator) such that an element
+ * a belongs above b whenever Compare(a, b) holds.
+ *
+ * Only the elements in the heap are ever constructed: spare capacity is
+ * uninitialized storage, so Comparable need not be default constructible, and
+ * emplace() constructs a new element directly in the slot it is sifted up
+ * from. The elements are stored in memory obtained from the Allocator
+ * (default = std::allocator<Comparable>); PmrMinimumHeap uses a
+ * std::pmr::polymorphic_allocator so that a heap can live in a memory
+ * resource such as a per-request std::pmr::monotonic_buffer_resource, and
+ * MinimumHeapHugePageAllocator backs a heap much larger than the reach of the
+ * TLB with huge pages (see also BlockedMinimumHeap). When the heap is full,
+ * insert grows the capacity as set by the Growth policy
+ * (default = MinimumHeapDoublingGrowth). The capacity never shrinks by itself:
+ * clear() keeps it, so a cleared heap, or one sized with reserve(), does not
+ * allocate again until it outgrows that capacity. shrink_to_fit() returns the
+ * unused capacity to the Allocator.
+ *
+ * Elements leave the heap through pop() or, many at once (e.g. all the jobs
+ * of a cancelled tenant), through erase_if(), which compacts the heap in
+ * place; TombstoneMinimumHeap cancels single elements in O(1).
+ *
+ * sorted() iterates over the elements in ascending order without changing the
+ * heap, at a cost proportional to the number of elements visited, and
+ * drain_sorted() removes them in ascending order by an in-place heapsort.
+ *
+ * Building a heap from a vector and sorting its elements (sorted_drain) can
+ * opt in to parallel algorithms with the MinimumHeapParallel execution policy.
+ *
+ * The Stats policy (default = MinimumHeapNoStats, or MinimumHeapStats when
+ * MINIMUMHEAP_STATS is defined) records the work done by the heap, readable
+ * through stats(): comparisons, moves, sift depths, rebuilds, reallocations
+ * and the peak size. With MinimumHeapNoStats nothing is recorded and the heap
+ * compiles to the same code as without the policy.
  *
  * @author Ken Loomis (https://github.com/kjloomis3)
  */
-template <typename Comparable> class MinimumHeap {
+template <typename Comparable, size_t Arity = 2,
+          MinimumHeapPop Pop = MinimumHeapPop::TopDown,
+          typename Compare = std::less<Comparable>,
+          typename Allocator = std::allocator<Comparable>,
+          typename Growth = MinimumHeapDoublingGrowth,
+          typename Stats = MinimumHeapDefaultStats> class MinimumHeap {
+
+    static_assert ( Arity >= 2, "MinimumHeap requires an Arity of at least 2." );
 
 private:
 
-    /** The _elements of the MinimumHeap arranged in a vector. **/
-    std::vector<Comparable> _elements;
+    /** The _elements of the MinimumHeap arranged in a vector, whose size is
+     * the size of the MinimumHeap and whose capacity is its capacity. **/
+    std::vector<Comparable, Allocator> _elements;
 
-    /** The current size of the MinimumHeap **/
-    size_t _size;
+    /** The function object used to order the elements. **/
+    Compare _compare;
 
-    /**
-     * Produces the index of the left child of the given index.
-     * @param index: the index of the parent element
-     * @return the index of the left child.
-     */
-    static size_t leftChild ( size_t index );
+    /** The statistics recorded by the Stats policy. **/
+    Stats _stats;
 
-    /**
-     * Produces the index of the right child of the given index.
-     * @param index: the index of the parent element
-     * @return the index of the left child.
-     */
-    static size_t rightChild ( size_t index );
+    /** The sift engine for the Arity of the MinimumHeap. **/
+    typedef MinimumHeapSift<Arity> Sift;
 
-    /**
-     * Produces the index of the parent of the given index.
-     * @param index: the index of the child element
-     * @return the index of the parent.
-     */
-    static size_t parent ( size_t index );
+    /** The comparison and placement observer passed to the sift engine,
+     * which record statistics if the Stats policy is enabled. **/
+    typedef MinimumHeapStatsLess<Compare, Stats> StatsLess;
+    typedef MinimumHeapStatsPlacement<Stats> StatsPlacement;
 
     /**
      * Moves the element at the given index down in the heap as necessary
@@ -71,14 +189,56 @@ private:
      */
     void makeMinHeap();
 
+    /**
+     * Minifies the heap such that the resulting heap is a MinimumHeap, in
+     * parallel as set by the given policy (sequentially while recording
+     * statistics, whose counters are not shared between threads).
+     * @param policy: the parallel execution policy.
+     */
+    void makeMinHeap ( const MinimumHeapParallel& policy );
+
+    /**
+     * Refills the hole left at the root by removing the top element with the
+     * last element of the heap, removing its slot, using the Pop strategy of
+     * the MinimumHeap.
+     */
+    void fillRoot();
+
+    /**
+     * Increases the capacity of the heap, as set by the Growth policy, so that
+     * at least the given number of elements fit.
+     * @param capacity: the minimum number of elements required.
+     */
+    void grow ( size_t capacity );
+
+    /**
+     * Restores the minimum property of the heap after the elements from index
+     * first to the end of the heap have been appended, either by sifting up
+     * each appended element or by rebuilding the whole heap, whichever is
+     * expected to be cheaper for the number of elements appended.
+     * @param first: the index of the first appended element.
+     */
+    void heapifyAppended ( size_t first );
+
  public:
 
     /**
-     * Instantiate a MinimumHeap given the initial capacity (default = 2)
-     * of the underlying vector.
+     * Instantiate an empty MinimumHeap given the initial capacity (default =
+     * 2) of the underlying vector. No elements are constructed.
      * @param capacity: the initial capacity.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit MinimumHeap(size_t capacity = 2, const Compare& compare = Compare(),
+                         const Allocator& allocator = Allocator());
+
+    /**
+     * Instantiate an empty MinimumHeap whose elements are stored in memory
+     * obtained from the given allocator. Nothing is allocated until the
+     * first insert (or reserve).
+     * @param allocator: the allocator of the underlying vector (for a
+     * PmrMinimumHeap, a std::pmr::memory_resource pointer converts to one).
     **/
-    explicit MinimumHeap(size_t capacity = 2);
+    explicit MinimumHeap(const Allocator& allocator);
 
     /**
      * Instantiate a MinimumHeap by copying an existing MinimumHeap.
@@ -118,14 +278,37 @@ private:
     /**
      * Instantiate a MinimumHeap by copying elements from the given vector.
      * @param vec: the vector to copy elements from.
+     * @param compare: the function object used to order the elements.
     **/
-    MinimumHeap(const std::vector<Comparable>& vec);
+    MinimumHeap(const std::vector<Comparable>& vec, const Compare& compare = Compare(),
+                const Allocator& allocator = Allocator());
 
     /**
      * Instantiate a MinimumHeap by moving elements from the given vector.
      * @param vec: the vector to move elements from.
+     * @param compare: the function object used to order the elements.
     **/
-    MinimumHeap(std::vector<Comparable>&& vec);
+    MinimumHeap(std::vector<Comparable, Allocator>&& vec, const Compare& compare = Compare());
+
+    /**
+     * Instantiate a MinimumHeap by copying elements from the given vector,
+     * building the heap in parallel (see MinimumHeapParallelSift::makeHeap).
+     * @param policy: the parallel execution policy.
+     * @param vec: the vector to copy elements from.
+     * @param compare: the function object used to order the elements.
+    **/
+    MinimumHeap(const MinimumHeapParallel& policy, const std::vector<Comparable>& vec,
+                const Compare& compare = Compare(), const Allocator& allocator = Allocator());
+
+    /**
+     * Instantiate a MinimumHeap by moving elements from the given vector,
+     * building the heap in parallel (see MinimumHeapParallelSift::makeHeap).
+     * @param policy: the parallel execution policy.
+     * @param vec: the vector to move elements from.
+     * @param compare: the function object used to order the elements.
+    **/
+    MinimumHeap(const MinimumHeapParallel& policy, std::vector<Comparable, Allocator>&& vec,
+                const Compare& compare = Compare());
 
     /**
      * Produces the current size of the MinimumHeap.
@@ -133,6 +316,13 @@ private:
      */
     size_t size() const;
 
+    /**
+     * Produces the number of elements the MinimumHeap can hold before its
+     * underlying vector must grow.
+     * @return the capacity of the MinimumHeap.
+     */
+    size_t capacity() const;
+
     /**
      * Determines if the MinimumHeap is empty (it contains no elements).
      * @return true if the MinimumHeap is empty, false otherwise.
@@ -141,11 +331,31 @@ private:
 
     /**
      * Resets the MinimumHeap to be empty (it will contain no elements).
-     * The current capacity of the heap remains unchanged.
-     * @return true if the heap is empty, false otherwise.
+     * The current capacity of the heap remains unchanged, so inserting up to
+     * capacity() elements afterwards does not allocate.
      */
     void clear();
 
+    /**
+     * Increases the capacity of the MinimumHeap to at least the given number
+     * of elements, so that inserting up to that many does not allocate.
+     * Does nothing if the capacity is already large enough.
+     * @param capacity: the number of elements that must fit.
+     */
+    void reserve ( size_t capacity );
+
+    /**
+     * Reduces the capacity of the MinimumHeap to its size, releasing the
+     * unused memory to the Allocator.
+     */
+    void shrink_to_fit ( );
+
+    /**
+     * Produces the allocator used to store the elements.
+     * @return a copy of the allocator.
+     */
+    Allocator get_allocator ( ) const;
+
     /**
      * Produces the element at the top of the heap (the smallest element in
      * the heap) without removing it from the heap.
@@ -157,26 +367,28 @@ private:
     /**
      * Produces the element in the MinimumHeap at the given index position.
      * Positions are indexed from the first element (index 0) and increase
-     * with each left-to-right, within each depth such that the element at
+     * with each left-to-right, within each depth such that the elements at
+     * index 1 through Arity are the children of index 0 (for a binary heap,
      * index 1 is the left element of index 0, and index 2 is the right
-     * element of index 0.
+     * element of index 0).
      * @param index: the index of the element to return.
      * @return the value of the element at the given index.
      * @throws MinimumHeapIndexOutOfBoundsException if the index is not within
-     * the bounds (0, size].
+     * the bounds [0, size).
      */
     const Comparable& at ( size_t index ) const;
 
     /**
      * Produces the element in the MinimumHeap at the given index position.
      * Positions are indexed from the first element (index 0) and increase
-     * with each left-to-right, within each depth such that the element at
+     * with each left-to-right, within each depth such that the elements at
+     * index 1 through Arity are the children of index 0 (for a binary heap,
      * index 1 is the left element of index 0, and index 2 is the right
-     * element of index 0.
+     * element of index 0).
      * @param index: the index of the element to return.
      * @return the value of the element at the given index.
      * @throws MinimumHeapIndexOutOfBoundsException if the index is not within
-     * the bounds (0, size].
+     * the bounds [0, size).
      */
     const Comparable& operator[] ( size_t index ) const;
 
@@ -185,7 +397,7 @@ private:
      * in the heap such that the minimum property of the heap is preserved.
      *
      * If the heap is full at the time of insertion, the capacity of the heap
-     * is doubled in size.
+     * grows as set by the Growth policy.
      *
      * @param element: the element to be inserted into the heap
      */
@@ -197,12 +409,43 @@ private:
      * property of the heap is preserved.
      *
      * If the heap is full at the time of insertion, the capacity of the heap
-     * is doubled in size.
+     * grows as set by the Growth policy.
      *
      * @param element: the element to be inserted (moved) into the heap
      */
     void insert ( Comparable&& obj);
 
+    /**
+     * Constructs an element from the given arguments directly in the last
+     * slot of the MinimumHeap, then sifts it up to the appropriate position
+     * such that the minimum property of the heap is preserved. The element is
+     * constructed exactly once, and only moved if it belongs above its parent.
+     *
+     * If the heap is full at the time of insertion, the capacity of the heap
+     * grows as set by the Growth policy.
+     *
+     * @param args: the arguments passed to the constructor of Comparable.
+     */
+    template <typename... Args>
+    void emplace ( Args&&... args );
+
+    /**
+     * Inserts the elements in the range [first, last) into the MinimumHeap such
+     * that the minimum property of the heap is preserved. Use move iterators
+     * (std::make_move_iterator) to move the elements rather than copy them.
+     *
+     * The capacity of the heap grows at most once for a range whose size is
+     * known in advance. The appended elements are either sifted up one at a
+     * time or, when the range is large compared to the heap, the whole heap
+     * is rebuilt in linear time. If an element fails to be inserted (its
+     * copy or move throws), none of the range is: the heap is left as it was.
+     *
+     * @param first: the beginning of the range of elements to be inserted.
+     * @param last: the end of the range of elements to be inserted.
+     */
+    template <typename InputIterator>
+    void insert_range ( InputIterator first, InputIterator last );
+
     /**
      * Produces the element at the top of the heap (the smallest element in
      * the heap) and removes it from the heap preserving the minimum property
@@ -222,6 +465,162 @@ private:
      */
     void pop (Comparable& element);
 
+    /**
+     * Removes the k smallest elements from the heap, moving them in ascending
+     * order to the given output iterator.
+     * @param k: the number of elements to be removed.
+     * @param out: the destination of the removed elements.
+     * @return the output iterator past the last element written.
+     * @throws MinimumHeapUnderflowException if the MinimumHeap contains fewer
+     * than k elements
+     */
+    template <typename OutputIterator>
+    OutputIterator pop_n ( size_t k, OutputIterator out );
+
+    /**
+     * Removes every element from the heap, producing them in ascending order.
+     * The heap is sorted in place (heapsort, without rebuilding it) and its
+     * underlying vector is returned, so no element is copied (the heap is
+     * left empty, without capacity).
+     * @return the elements of the heap in ascending order.
+     */
+    std::vector<Comparable, Allocator> sorted_drain ( );
+
+    /**
+     * Removes every element from the heap, producing them in ascending order,
+     * sorted in parallel (see MinimumHeapParallelSift::sort): chunks are
+     * heapsorted concurrently and then merged, through a buffer as large as
+     * the heap, obtained from its Allocator. The heap is left empty, without
+     * capacity.
+     * @param policy: the parallel execution policy.
+     * @return the elements of the heap in ascending order.
+     */
+    std::vector<Comparable, Allocator> sorted_drain ( const MinimumHeapParallel& policy );
+
+    /**
+     * Produces the elements of the heap in ascending order, lazily and
+     * without changing or copying the heap: iterating over the first k
+     * elements costs O(k log k) (see MinimumHeapSortedIterator), e.g. for the
+     * next k deadlines. The range is a forward range (and a view) referring
+     * to the elements of the heap, which must not change while it is in use.
+     * @return the range of the elements in ascending order.
+     */
+    MinimumHeapSortedRange<Comparable, Arity, Compare> sorted ( ) const;
+
+    /**
+     * Produces the elements of the heap in ascending order, removing each
+     * from the heap as the iteration moves past it, by an in-place heapsort
+     * of the underlying vector run one step at a time (see
+     * MinimumHeapDrainRange). Elements not iterated past stay in the heap,
+     * which must not be used until the range is destroyed.
+     * @return the input range of the elements in ascending order.
+     */
+    MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator> drain_sorted ( );
+
+    /**
+     * Moves every element of the given MinimumHeap into this one, leaving the
+     * given heap empty. The elements of the smaller heap are appended to the
+     * larger (whose buffer is taken over when the allocators are equal) and
+     * either sifted up one at a time or, when that is expected to be more
+     * expensive, the whole heap is rebuilt in linear time: O(m log n) at
+     * worst for a small heap of m elements merged into a large one of n, and
+     * O(n + m) otherwise. The order of the elements is that of this heap.
+     * @param other: the MinimumHeap to be merged (moved) into this one.
+     */
+    void merge ( MinimumHeap&& other );
+
+    /**
+     * Removes every element for which the given predicate holds, compacting
+     * the underlying vector in place (its capacity is kept). The elements
+     * before the first one removed are left where they are, as they still
+     * form a heap; those after it are moved down over the removed ones and
+     * then restored as if appended (see insert_range): sifted up one at a
+     * time when few, otherwise the whole heap is rebuilt in linear time. A
+     * call that removes nothing costs one pass of the predicate only.
+     * @param predicate: called once on each element (as a const Comparable&),
+     * in index order; returns true for the elements to be removed.
+     * @return the number of elements removed.
+     */
+    template <typename Predicate>
+    size_t erase_if ( Predicate predicate );
+
+    /**
+     * Removes the element at the top of the heap and inserts the given
+     * element in its place with a single sift down. Equivalent to pop()
+     * followed by insert(), but never grows the heap.
+     * @param element: the element to be inserted into the heap
+     * @return the value of the smallest element before the replacement.
+     * @throws MinimumHeapUnderflowException if the MinimumHeap is empty
+     */
+    Comparable replace_top ( const Comparable& element );
+
+    /**
+     * Removes the element at the top of the heap and inserts (moves) the given
+     * element in its place with a single sift down. Equivalent to pop()
+     * followed by insert(), but never grows the heap.
+     * @param element: the element to be inserted (moved) into the heap
+     * @return the value of the smallest element before the replacement.
+     * @throws MinimumHeapUnderflowException if the MinimumHeap is empty
+     */
+    Comparable replace_top ( Comparable&& element );
+
+    /**
+     * Inserts the given element into the heap and then removes the smallest
+     * element. Equivalent to insert() followed by pop(), but when the given
+     * element would be the smallest it is returned after a single comparison
+     * with top() without changing the heap; otherwise it replaces the top with
+     * a single sift down. Never grows the heap.
+     * @param element: the element to be inserted into the heap
+     * @return the smallest of the given element and the heap's elements.
+     */
+    Comparable push_pop ( const Comparable& element );
+
+    /**
+     * Inserts (moves) the given element into the heap and then removes the
+     * smallest element. Equivalent to insert() followed by pop(), but when the
+     * given element would be the smallest it is returned after a single
+     * comparison with top() without changing the heap; otherwise it replaces
+     * the top with a single sift down. Never grows the heap.
+     * @param element: the element to be inserted (moved) into the heap
+     * @return the smallest of the given element and the heap's elements.
+     */
+    Comparable push_pop ( Comparable&& element );
+
+    /**
+     * Writes a binary snapshot of the heap to the given stream: a
+     * MinimumHeapSnapshotHeader followed by the elements as raw bytes, in heap
+     * order. Requires a trivially copyable Comparable.
+     * @param out: the (binary) output stream to be written to.
+     * @throws MinimumHeapSnapshotException if the stream fails
+     */
+    void save ( std::ostream& out ) const;
+
+    /**
+     * Reads a binary snapshot written by save() straight into the underlying
+     * vector of a new MinimumHeap. The elements are already in heap order, so
+     * they are not sifted: loading costs one read of the file plus one pass
+     * to verify the checksum. Requires a trivially copyable Comparable.
+     * @param in: the (binary) input stream to be read from.
+     * @param compare: the function object used to order the elements, which
+     * must order them as the saved heap did.
+     * @param allocator: the allocator of the underlying vector.
+     * @return the loaded MinimumHeap.
+     * @throws MinimumHeapSnapshotException if the stream fails, or the header
+     * does not match the heap (Arity, element size, version, byte order), or
+     * its count of elements is more than the stream holds (checked before
+     * allocating when the stream can seek, otherwise while reading), or the
+     * checksum does not match the elements
+     */
+    static MinimumHeap load ( std::istream& in, const Compare& compare = Compare(),
+                              const Allocator& allocator = Allocator() );
+
+    /**
+     * Produces the statistics recorded by the Stats policy of the heap (an
+     * empty MinimumHeapNoStats if it records none).
+     * @return the statistics of the heap.
+     */
+    const Stats& stats ( ) const;
+
     /**
      * Produces the elements in MinimumHeap to the given output stream. The
      * format of the output is such that the heap with elements 1, 2, 3, 4,
@@ -246,11 +645,25 @@ private:
  * and 5 will be outputted as "MinimumHeap [1, 2, 3, 4, 5]"
  * @param out: the output stream to be updated.
  */
-template <typename Comparable>
-std::ostream& operator<< (std::ostream& out, const MinimumHeap<Comparable>& h);
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+std::ostream& operator<< (std::ostream& out,
+                          const MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>& h);
+
+/**
+ * A MinimumHeap whose elements are stored in a std::pmr::memory_resource,
+ * e.g. PmrMinimumHeap<int> heap ( &arena ).
+ */
+template <typename Comparable, size_t Arity = 2,
+          MinimumHeapPop Pop = MinimumHeapPop::TopDown,
+          typename Compare = std::less<Comparable>,
+          typename Growth = MinimumHeapDoublingGrowth,
+          typename Stats = MinimumHeapDefaultStats>
+using PmrMinimumHeap = MinimumHeap<Comparable, Arity, Pop, Compare,
+                                   std::pmr::polymorphic_allocator<Comparable>, Growth, Stats>;
 
 /** Includes the templated class implementation to be compiled during usage of
  * the class. **/
-#include "minimumHeap.tpp"
+#include "minimumheap.tpp"
 
 #endif // MINIMUMHEAP_H
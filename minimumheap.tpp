@@ -1,164 +1,540 @@
 #include "minimumheap.h"
 
-template <typename Comparable>
-size_t MinimumHeap<Comparable>::leftChild ( size_t index )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::minimumHeapify (size_t i)
 {
-    return 2 * index + 1;
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Comparable value = std::move( _elements[i] );
+    Sift::siftDown( _elements.data(), _elements.size(), i, std::move(value), less, placed );
+    _stats.siftedDown( placed.depth() );
 }
 
-template <typename Comparable>
-size_t MinimumHeap<Comparable>::rightChild ( size_t index )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::makeMinHeap()
 {
-    return 2 * index + 2;
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Sift::makeHeap( _elements.data(), _elements.size(), less, placed );
+    _stats.rebuilt();
 }
 
-template <typename Comparable>
-size_t MinimumHeap<Comparable>::parent ( size_t index )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::makeMinHeap ( const MinimumHeapParallel& policy )
 {
-    return ( index - 1 ) / 2;
+    if ( Stats::enabled )
+    {
+        makeMinHeap();
+        return;
+    }
+    MinimumHeapParallelSift<Arity>::makeHeap( _elements.data(), _elements.size(), _compare, policy.count() );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::fillRoot()
+{
+    Comparable last = std::move( _elements.back() );
+    _elements.pop_back();
+    if ( _elements.empty() )
+        return;
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Sift::template fillHole<Pop>( _elements.data(), _elements.size(), 0, std::move(last), less, placed );
+    _stats.siftedDown( placed.depth() );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::grow ( size_t capacity )
+{
+    if ( capacity > _elements.capacity() )
+    {
+        _elements.reserve( Growth::next( _elements.capacity(), capacity ) );
+        _stats.reallocated();
+    }
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::minimumHeapify (size_t i)
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::heapifyAppended ( size_t first )
 {
-    size_t l = leftChild(i);
-    size_t r = rightChild(i);
-    size_t smallest = i;
-    if ( l < _size && _elements[l] < _elements[i] )
-        smallest = l;
-    else
-        smallest = i;
-    if ( r < _size && _elements[r] < _elements[smallest] )
-        smallest = r;
-    if ( smallest != i )
+    // Sifting up costs at most log_Arity(size) moves per appended element,
+    // rebuilding costs a bounded number of moves per element of the heap.
+    size_t size = _elements.size();
+    size_t appended = size - first;
+    size_t depth = 0;
+    for ( size_t n = size; n > 0; n /= Arity )
+        depth++;
+    if ( appended * depth > size )
     {
-        std::swap ( _elements[i], _elements[smallest] );
-        minimumHeapify( smallest );
+        makeMinHeap();
+        return;
+    }
+
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    for ( size_t i = first; i < size; i++ )
+    {
+        StatsPlacement placed ( _stats );
+        Sift::siftUpInPlace( _elements.data(), 0, i, less, placed );
+        _stats.siftedUp( placed.depth() );
     }
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::makeMinHeap()
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(size_t capacity, const Compare& compare,
+                                                                     const Allocator& allocator)
+    : _elements(allocator), _compare{ compare }
 {
-    for ( size_t i=parent( _size - 1 ); i < _size; i-- )
-        minimumHeapify(i);
+    _elements.reserve( capacity );
 }
 
-template <typename Comparable>
-MinimumHeap<Comparable>::MinimumHeap(size_t capacity)
-    : _elements(capacity), _size{ 0 } {}
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(const Allocator& allocator)
+    : _elements(allocator), _compare{ } {}
 
-template <typename Comparable>
-MinimumHeap<Comparable>::MinimumHeap(const std::vector<Comparable>& vec)
-    : _elements{ vec }
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(const std::vector<Comparable>& vec, const Compare& compare,
+                                                                     const Allocator& allocator)
+    : _elements(vec.begin(), vec.end(), allocator), _compare{ compare }
 {
-    _size = _elements.size();
+    _stats.resized( _elements.size() );
     makeMinHeap();
 }
 
-template <typename Comparable>
-MinimumHeap<Comparable>::MinimumHeap(std::vector<Comparable>&& vec)
-    : _elements{ std::move(vec) }
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(std::vector<Comparable, Allocator>&& vec, const Compare& compare)
+    : _elements{ std::move(vec) }, _compare{ compare }
 {
-    _size = _elements.size();
+    _stats.resized( _elements.size() );
     makeMinHeap();
 }
 
-template <typename Comparable>
-size_t MinimumHeap<Comparable>::size() const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(const MinimumHeapParallel& policy, const std::vector<Comparable>& vec,
+                                                                     const Compare& compare, const Allocator& allocator)
+    : _elements(vec.begin(), vec.end(), allocator), _compare{ compare }
 {
-    return _size;
+    _stats.resized( _elements.size() );
+    makeMinHeap( policy );
 }
 
-template <typename Comparable>
-bool MinimumHeap<Comparable>::empty() const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::MinimumHeap(const MinimumHeapParallel& policy, std::vector<Comparable, Allocator>&& vec,
+                                                                     const Compare& compare)
+    : _elements{ std::move(vec) }, _compare{ compare }
 {
-    return _size==0;
+    _stats.resized( _elements.size() );
+    makeMinHeap( policy );
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::clear()
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+size_t MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::size() const
+{
+    return _elements.size();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+size_t MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::capacity() const
+{
+    return _elements.capacity();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+bool MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::empty() const
+{
+    return _elements.empty();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::clear()
 {
-    _size = 0;
     _elements.clear();
 }
 
-template <typename Comparable>
-const Comparable& MinimumHeap<Comparable>::top ( ) const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::reserve ( size_t capacity )
+{
+    if ( capacity > _elements.capacity() )
+    {
+        _elements.reserve( capacity );
+        _stats.reallocated();
+    }
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::shrink_to_fit ( )
+{
+    size_t capacity = _elements.capacity();
+    _elements.shrink_to_fit();
+    if ( _elements.capacity() != capacity )
+        _stats.reallocated();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Allocator MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::get_allocator ( ) const
+{
+    return _elements.get_allocator();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+const Comparable& MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::top ( ) const
 {
     if ( empty() ) { throw MinimumHeapUnderflowException(); }
     return _elements[0];
 }
 
-template <typename Comparable>
-const Comparable& MinimumHeap<Comparable>::at ( size_t index ) const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+const Comparable& MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::at ( size_t index ) const
 {
-    if ( index > _size ) { throw MinimumHeapIndexOutOfBoundsException(); }
+    if ( index >= _elements.size() ) { throw MinimumHeapIndexOutOfBoundsException(); }
     return _elements[index];
 }
 
-template <typename Comparable>
-const Comparable& MinimumHeap<Comparable>::operator[] ( size_t index ) const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+const Comparable& MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::operator[] ( size_t index ) const
 {
     return at ( index );
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::insert ( const Comparable& element )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::insert ( const Comparable& element )
 {
-    Comparable copy = element;
-    insert( std::move(copy) );
+    emplace( element );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::insert ( Comparable&& obj)
+{
+    size_t hole = _elements.size();
+    grow( hole + 1 );
+    _stats.resized( hole + 1 );
+    _stats.moved();
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    if ( hole == 0 || !less( obj, _elements[Sift::parent( hole )] ) )
+    {
+        _elements.push_back( std::move(obj) );
+        _stats.siftedUp( 0 );
+        return;
+    }
+    // The new last slot is constructed from the parent of the hole, which
+    // becomes the hole the element is sifted up from.
+    StatsPlacement placed ( _stats );
+    size_t parent = Sift::parent( hole );
+    _elements.push_back( std::move(_elements[parent]) );
+    Sift::siftUp( _elements.data(), 0, parent, std::move(obj), less, placed );
+    _stats.siftedUp( placed.depth() + 1 );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+template <typename... Args>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::emplace ( Args&&... args )
+{
+    grow( _elements.size() + 1 );
+    _elements.emplace_back( std::forward<Args>(args)... );
+    _stats.resized( _elements.size() );
+    _stats.moved();
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Sift::siftUpInPlace( _elements.data(), 0, _elements.size() - 1, less, placed );
+    _stats.siftedUp( placed.depth() );
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::insert ( Comparable&& obj)
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+template <typename InputIterator>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::insert_range ( InputIterator first, InputIterator last )
 {
-    if ( _size == _elements.size() )
+    typedef typename std::iterator_traits<InputIterator>::iterator_category Category;
+    if ( std::is_base_of<std::forward_iterator_tag, Category>::value )
+        grow( _elements.size() + std::distance( first, last ) );
+
+    // The elements are only sifted once all are appended: if one fails to be
+    // appended, those before it are removed again before rethrowing.
+    size_t appended = _elements.size();
+    try
     {
-        size_t newSize = 2;
-        if ( _size != 0 ) { newSize = _size * 2; }
-        _elements.resize( newSize );
+        for ( ; first != last; ++first )
+        {
+            grow( _elements.size() + 1 );
+            _elements.emplace_back( *first );
+            _stats.moved();
+        }
     }
-    _elements[_size] = obj;
-    for (size_t i = _size; i > 0 && _elements[i] < _elements[ parent(i) ]; i = parent(i))
+    catch ( ... )
     {
-        std::swap(_elements[i], _elements[ parent(i) ]);
+        _elements.erase( _elements.begin() + appended, _elements.end() );
+        throw;
     }
-    _size++;
+    _stats.resized( _elements.size() );
+    if ( _elements.size() > appended )
+        heapifyAppended( appended );
 }
 
-template <typename Comparable>
-Comparable MinimumHeap<Comparable>::pop ()
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Comparable MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::pop ()
 {
     if ( empty() ) { throw MinimumHeapUnderflowException(); }
     Comparable min = std::move(_elements[0]);
-    _size--;
-    if ( _size > 0)
+    fillRoot();
+    return min;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::pop (Comparable& element)
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    element = std::move(_elements[0]);
+    fillRoot();
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+template <typename OutputIterator>
+OutputIterator MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::pop_n ( size_t k, OutputIterator out )
+{
+    if ( k > _elements.size() ) { throw MinimumHeapUnderflowException(); }
+    for ( ; k > 0; k-- )
     {
-        _elements[0] = std::move(_elements[_size]);
-        minimumHeapify(0);
+        *out = std::move(_elements[0]);
+        ++out;
+        fillRoot();
     }
-    return std::move(min);
+    return out;
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::pop (Comparable& element)
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+std::vector<Comparable, Allocator> MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::sorted_drain ( )
+{
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Sift::template sortHeap<Pop>( _elements.data(), _elements.size(), less, placed );
+    std::reverse( _elements.begin(), _elements.end() );
+    std::vector<Comparable, Allocator> sorted ( std::move(_elements) );
+    _elements.clear();
+    return sorted;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+std::vector<Comparable, Allocator> MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::sorted_drain ( const MinimumHeapParallel& policy )
+{
+    if ( Stats::enabled )
+        return sorted_drain();
+    MinimumHeapParallelSift<Arity>::template sort<Pop>( _elements.data(), _elements.size(), _compare, policy.count(),
+                                                        _elements.get_allocator() );
+    std::vector<Comparable, Allocator> sorted ( std::move(_elements) );
+    _elements.clear();
+    return sorted;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeapSortedRange<Comparable, Arity, Compare> MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::sorted ( ) const
+{
+    return MinimumHeapSortedRange<Comparable, Arity, Compare>( _elements.data(), _elements.size(), _compare );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator> MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::drain_sorted ( )
+{
+    return MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>( _elements, _compare );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::merge ( MinimumHeap&& other )
+{
+    if ( &other == this || other.empty() )
+        return;
+    // Append the smaller heap to the larger one.
+    if ( other._elements.size() > _elements.size()
+         && _elements.get_allocator() == other._elements.get_allocator() )
+        _elements.swap( other._elements );
+
+    size_t appended = _elements.size();
+    grow( appended + other._elements.size() );
+    for ( size_t i = 0; i < other._elements.size(); i++ )
+    {
+        _elements.emplace_back( std::move( other._elements[i] ) );
+        _stats.moved();
+    }
+    _stats.resized( _elements.size() );
+    other._elements.clear();
+    heapifyAppended( appended );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+template <typename Predicate>
+size_t MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::erase_if ( Predicate predicate )
+{
+    size_t size = _elements.size();
+    size_t first = 0;
+    while ( first < size && !predicate( static_cast<const Comparable&>( _elements[first] ) ) )
+        first++;
+    if ( first == size )
+        return 0;
+
+    // A prefix of a heap is a heap: only the elements kept after the first
+    // removed one are moved, and then restored as if they were appended.
+    size_t kept = first;
+    for ( size_t i = first + 1; i < size; i++ )
+    {
+        if ( predicate( static_cast<const Comparable&>( _elements[i] ) ) )
+            continue;
+        _elements[kept++] = std::move( _elements[i] );
+        _stats.moved();
+    }
+    _elements.erase( _elements.begin() + kept, _elements.end() );
+    if ( kept > first )
+        heapifyAppended( first );
+    return size - kept;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Comparable MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::replace_top ( const Comparable& element )
+{
+    Comparable copy = element;
+    return replace_top( std::move(copy) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Comparable MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::replace_top ( Comparable&& element )
 {
     if ( empty() ) { throw MinimumHeapUnderflowException(); }
-    element = std::move(_elements[0]);
-    _size--;
-    if ( _size > 0)
+    typename StatsLess::type less = StatsLess::make( _compare, _stats );
+    StatsPlacement placed ( _stats );
+    Comparable min = std::move(_elements[0]);
+    Sift::siftDown( _elements.data(), _elements.size(), 0, std::move(element), less, placed );
+    _stats.siftedDown( placed.depth() );
+    return min;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Comparable MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::push_pop ( const Comparable& element )
+{
+    if ( empty() || !StatsLess::make( _compare, _stats )( _elements[0], element ) )
+        return element;
+    Comparable copy = element;
+    return replace_top( std::move(copy) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+Comparable MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::push_pop ( Comparable&& element )
+{
+    if ( empty() || !StatsLess::make( _compare, _stats )( _elements[0], element ) )
+        return std::move(element);
+    return replace_top( std::move(element) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::save ( std::ostream& out ) const
+{
+    static_assert ( std::is_trivially_copyable<Comparable>::value,
+                    "MinimumHeap::save requires a trivially copyable Comparable." );
+    MinimumHeapSnapshotHeader header = MinimumHeapSnapshotHeader::make(
+            Arity, sizeof(Comparable), _elements.data(), _elements.size() );
+    out.write( reinterpret_cast<const char*>( &header ), sizeof header );
+    out.write( reinterpret_cast<const char*>( _elements.data() ),
+               static_cast<std::streamsize>( _elements.size() * sizeof(Comparable) ) );
+    if ( !out ) { throw MinimumHeapSnapshotException(); }
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats> MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::load ( std::istream& in, const Compare& compare,
+                                                                                 const Allocator& allocator )
+{
+    static_assert ( std::is_trivially_copyable<Comparable>::value,
+                    "MinimumHeap::load requires a trivially copyable Comparable." );
+    MinimumHeapSnapshotHeader header;
+    if ( !in.read( reinterpret_cast<char*>( &header ), sizeof header )
+         || !header.matches( Arity, sizeof(Comparable) ) )
+        throw MinimumHeapSnapshotException();
+
+    MinimumHeap heap ( 0, compare, allocator );
+    if ( header.count > heap._elements.max_size()
+         || header.count > std::numeric_limits<size_t>::max() / sizeof(Comparable) )
+        throw MinimumHeapSnapshotException();
+    size_t count = static_cast<size_t>( header.count );
+    size_t bytes = count * sizeof(Comparable);
+
+    // A stream that knows its length refuses a count beyond it before
+    // anything is allocated, and the elements are then allocated once.
+    std::istream::pos_type start = in.tellg();
+    if ( start != std::istream::pos_type( -1 ) )
     {
-         _elements[0] = std::move(_elements[_size]);
-         minimumHeapify(0);
+        std::istream::pos_type end = in.seekg( 0, std::ios::end ).tellg();
+        in.seekg( start );
+        if ( !in || end == std::istream::pos_type( -1 )
+             || static_cast<unsigned long long>( end - start ) < bytes )
+            throw MinimumHeapSnapshotException();
+        heap._elements.reserve( count );
     }
+
+    // Otherwise the elements are read a chunk at a time, so a corrupt count
+    // fails at the end of the stream having allocated no more than was read.
+    const size_t chunk = std::max<size_t>( 1, ( 1 << 20 ) / sizeof(Comparable) );
+    for ( size_t read = 0; read < count; )
+    {
+        size_t n = std::min( chunk, count - read );
+        heap._elements.resize( read + n );
+        if ( !in.read( reinterpret_cast<char*>( heap._elements.data() + read ),
+                       static_cast<std::streamsize>( n * sizeof(Comparable) ) ) )
+            throw MinimumHeapSnapshotException();
+        read += n;
+    }
+    if ( MinimumHeapSnapshotHeader::hash( heap._elements.data(), bytes ) != header.checksum )
+        throw MinimumHeapSnapshotException();
+    heap._stats.resized( heap._elements.size() );
+    return heap;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+const Stats& MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::stats ( ) const
+{
+    return _stats;
 }
 
-template <typename Comparable>
-void MinimumHeap<Comparable>::output ( std::ostream& out ) const
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+void MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::output ( std::ostream& out ) const
 {
     out << "MinimumHeap [";
-    for (size_t i=0; i<_size; i++) {
+    for (size_t i=0; i<_elements.size(); i++) {
       if ( i > 0 )
         out << ", ";
       out << _elements[i];
@@ -167,18 +543,18 @@ void MinimumHeap<Comparable>::output ( std::ostream& out ) const
     out.flush();
 }
 
-template <typename Comparable>
-std::string MinimumHeap<Comparable>::to_string ( )
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+std::string MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>::to_string ( )
 {
     std::stringstream ss;
-    std::string str;
     output ( ss );
-    ss >> str;
-    return str;
+    return ss.str();
 }
 
-template <typename Comparable>
-std::ostream& operator<< (std::ostream& out, const MinimumHeap<Comparable>& h)
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare,
+          typename Allocator, typename Growth, typename Stats>
+std::ostream& operator<< (std::ostream& out, const MinimumHeap<Comparable, Arity, Pop, Compare, Allocator, Growth, Stats>& h)
 {
     h.output(out);
     return out;
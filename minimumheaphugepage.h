@@ -0,0 +1,83 @@
+#ifndef MINIMUMHEAPHUGEPAGE_H
+#define MINIMUMHEAPHUGEPAGE_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/**
+ * An allocator which backs large allocations with huge pages, for heaps much
+ * larger than the reach of the TLB: a 2 MiB page maps as much memory with one
+ * TLB entry as 512 pages of 4 KiB, so the levels of a sift through a large
+ * heap stop missing the TLB one after the other.
+ *
+ * An allocation of at least HugePage bytes is rounded up to a whole number of
+ * huge pages, aligned on a huge page and, on Linux, advised to be backed by
+ * transparent huge pages (madvise MADV_HUGEPAGE, which takes effect when
+ * /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise").
+ * Elsewhere, or when the kernel has no huge page to spare, the memory is
+ * backed by ordinary pages. Smaller allocations use operator new.
+ *
+ * Use it as the Allocator of a MinimumHeap or a BlockedMinimumHeap, e.g.
+ * MinimumHeap<uint64_t, 2, MinimumHeapPop::TopDown, std::less<uint64_t>,
+ * MinimumHeapHugePageAllocator<uint64_t>>.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename T> struct MinimumHeapHugePageAllocator {
+
+    typedef T value_type;
+
+    /** The size of a huge page (x86-64 and AArch64 with 4 KiB pages). **/
+    static constexpr size_t HugePage = size_t ( 2 ) << 20;
+
+    MinimumHeapHugePageAllocator ( ) = default;
+
+    template <typename U>
+    MinimumHeapHugePageAllocator ( const MinimumHeapHugePageAllocator<U>& ) {}
+
+    /**
+     * Allocates uninitialized memory for n elements.
+     * @param n: the number of elements.
+     * @return the memory allocated.
+     * @throws std::bad_alloc if the memory cannot be allocated
+     */
+    T* allocate ( size_t n )
+    {
+        size_t bytes = n * sizeof ( T );
+        if ( bytes < HugePage )
+            return static_cast<T*> ( ::operator new ( bytes ) );
+        bytes = ( bytes + HugePage - 1 ) / HugePage * HugePage;
+        void* memory = std::aligned_alloc ( HugePage, bytes );
+        if ( memory == nullptr ) { throw std::bad_alloc(); }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        madvise ( memory, bytes, MADV_HUGEPAGE );
+#endif
+        return static_cast<T*> ( memory );
+    }
+
+    /**
+     * Releases the memory of n elements obtained from allocate.
+     * @param memory: the memory allocated.
+     * @param n: the number of elements it was allocated for.
+     */
+    void deallocate ( T* memory, size_t n )
+    {
+        if ( n * sizeof ( T ) < HugePage )
+            ::operator delete ( memory );
+        else
+            std::free ( memory );
+    }
+
+    template <typename U>
+    bool operator== ( const MinimumHeapHugePageAllocator<U>& ) const { return true; }
+
+    template <typename U>
+    bool operator!= ( const MinimumHeapHugePageAllocator<U>& ) const { return false; }
+};
+
+#endif // MINIMUMHEAPHUGEPAGE_H
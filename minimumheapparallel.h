@@ -0,0 +1,112 @@
+#ifndef MINIMUMHEAPPARALLEL_H
+#define MINIMUMHEAPPARALLEL_H
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "minimumheapsift.h"
+
+/**
+ * Execution policy selecting the sequential algorithms of a heap (the
+ * default of every operation which takes a policy).
+ */
+struct MinimumHeapSequential {};
+
+/**
+ * Execution policy opting in to the parallel algorithms of a heap, on the
+ * given number of threads (0, the default, uses one per hardware thread).
+ * Inputs too small to gain from it are still processed sequentially.
+ */
+struct MinimumHeapParallel {
+
+    size_t threads = 0;
+
+    /**
+     * Produces the number of threads to use.
+     * @return the given number of threads, or the number of hardware threads
+     * (at least 1) if none was given.
+     */
+    size_t count ( ) const
+    {
+        if ( threads > 0 )
+            return threads;
+        size_t hardware = std::thread::hardware_concurrency();
+        return hardware > 0 ? hardware : 1;
+    }
+};
+
+/**
+ * The parallel algorithms of the sift engine, run by forking one task per
+ * thread (the calling thread runs the first) and joining them. Each task
+ * uses its own copy of the comparison, which must therefore be safe to copy
+ * and to call from several threads at once. An exception thrown by a task
+ * is rethrown once every task has finished.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <size_t Arity> struct MinimumHeapParallelSift {
+
+    /** The sequential sift engine. **/
+    typedef MinimumHeapSift<Arity> Sift;
+
+    /** The smallest number of elements per thread worth a parallel pass. **/
+    static constexpr size_t Grain = 1 << 14;
+
+    /**
+     * Runs task ( t ) for each t in [0, threads) in parallel.
+     * @param threads: the number of tasks.
+     * @param task: the function object run by each task.
+     */
+    template <typename Task>
+    static void fork ( size_t threads, const Task& task );
+
+    /**
+     * Rearranges the given elements into a heap in parallel. The subtrees
+     * rooted at the first level with at least four roots per thread are
+     * independent: the roots are divided into one contiguous range per
+     * thread, and each thread builds the subtrees of its range bottom up
+     * (Floyd's method, one level range at a time). The levels above the cut
+     * are then built sequentially, which costs O(threads) sifts.
+     * @param elements: the elements of the heap.
+     * @param size: the number of elements.
+     * @param less: the comparison used to order the elements.
+     * @param threads: the number of threads.
+     */
+    template <typename Element, typename Less>
+    static void makeHeap ( Element* elements, size_t size, const Less& less, size_t threads );
+
+    /**
+     * Sorts the given elements into ascending order in parallel: each
+     * thread heapsorts a contiguous chunk of the elements, and the sorted
+     * chunks are then merged in pairs, the merges of each round running in
+     * parallel, through a buffer of the same size obtained from the given
+     * allocator (that of the heap being sorted).
+     * @param elements: the elements to sort.
+     * @param size: the number of elements.
+     * @param less: the comparison used to order the elements.
+     * @param threads: the number of threads.
+     * @param allocator: the allocator of the buffer.
+     */
+    template <MinimumHeapPop Pop, typename Element, typename Less,
+              typename Allocator = std::allocator<Element>>
+    static void sort ( Element* elements, size_t size, const Less& less, size_t threads,
+                       const Allocator& allocator = Allocator() );
+
+    /**
+     * Sorts the given heap into ascending order in place on the calling
+     * thread (heapsort, then a reversal).
+     * @param elements: the elements of the heap.
+     * @param size: the number of elements.
+     * @param less: the comparison used to order the elements.
+     */
+    template <MinimumHeapPop Pop, typename Element, typename Less>
+    static void sortHeap ( Element* elements, size_t size, Less& less );
+
+};
+
+/** Includes the templated implementation to be compiled during usage. **/
+#include "minimumheapparallel.tpp"
+
+#endif // MINIMUMHEAPPARALLEL_H
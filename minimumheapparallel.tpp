@@ -0,0 +1,141 @@
+#include "minimumheapparallel.h"
+#include <algorithm>
+#include <iterator>
+
+template <size_t Arity>
+template <typename Task>
+void MinimumHeapParallelSift<Arity>::fork ( size_t threads, const Task& task )
+{
+    std::vector<std::future<void>> tasks;
+    tasks.reserve ( threads );
+    for ( size_t t = 1; t < threads; t++ )
+        tasks.push_back ( std::async ( std::launch::async, task, t ) );
+    task ( 0 );
+    for ( std::future<void>& other : tasks )
+        other.get();
+}
+
+template <size_t Arity>
+template <typename Element, typename Less>
+void MinimumHeapParallelSift<Arity>::makeHeap ( Element* elements, size_t size, const Less& less,
+                                                size_t threads )
+{
+    if ( threads < 2 || size < 2 * Grain )
+    {
+        Less copy = less;
+        MinimumHeapIgnorePlacement placed;
+        Sift::makeHeap ( elements, size, copy, placed );
+        return;
+    }
+
+    // The cut: the first level with at least four roots per thread.
+    size_t last = Sift::parent ( size - 1 );
+    size_t first = 0;
+    size_t width = 1;
+    while ( width < 4 * threads && first <= last )
+    {
+        first = first * Arity + 1;
+        width *= Arity;
+    }
+    if ( first > last )
+    {
+        Less copy = less;
+        MinimumHeapIgnorePlacement placed;
+        Sift::makeHeap ( elements, size, copy, placed );
+        return;
+    }
+
+    fork ( threads, [=] ( size_t t )
+    {
+        Less copy = less;
+        MinimumHeapIgnorePlacement placed;
+        // The descendants of the roots [begin, end) on each level below are
+        // the contiguous range [Arity * begin + 1, Arity * end + 1).
+        std::vector<std::pair<size_t, size_t>> levels;
+        for ( size_t begin = first + width * t / threads, end = first + width * ( t + 1 ) / threads;
+              begin <= last && begin < end; begin = begin * Arity + 1, end = end * Arity + 1 )
+        {
+            end = std::min ( end, last + 1 );
+            levels.emplace_back ( begin, end );
+        }
+        for ( size_t l = levels.size(); l-- > 0; )
+        {
+            for ( size_t i = levels[l].second; i-- > levels[l].first; )
+            {
+                Element value = std::move ( elements[i] );
+                Sift::siftDown ( elements, size, i, std::move ( value ), copy, placed );
+            }
+        }
+    } );
+
+    Less copy = less;
+    MinimumHeapIgnorePlacement placed;
+    for ( size_t i = first; i-- > 0; )
+    {
+        Element value = std::move ( elements[i] );
+        Sift::siftDown ( elements, size, i, std::move ( value ), copy, placed );
+    }
+}
+
+template <size_t Arity>
+template <MinimumHeapPop Pop, typename Element, typename Less>
+void MinimumHeapParallelSift<Arity>::sortHeap ( Element* elements, size_t size, Less& less )
+{
+    MinimumHeapIgnorePlacement placed;
+    Sift::template sortHeap<Pop> ( elements, size, less, placed );
+    std::reverse ( elements, elements + size );
+}
+
+template <size_t Arity>
+template <MinimumHeapPop Pop, typename Element, typename Less, typename Allocator>
+void MinimumHeapParallelSift<Arity>::sort ( Element* elements, size_t size, const Less& less,
+                                            size_t threads, const Allocator& allocator )
+{
+    threads = std::min ( threads, size / Grain );
+    if ( threads < 2 )
+    {
+        Less copy = less;
+        MinimumHeapIgnorePlacement placed;
+        Sift::makeHeap ( elements, size, copy, placed );
+        sortHeap<Pop> ( elements, size, copy );
+        return;
+    }
+
+    // Heapsorts each chunk [bounds[t], bounds[t + 1]).
+    std::vector<size_t> bounds ( threads + 1 );
+    for ( size_t t = 0; t <= threads; t++ )
+        bounds[t] = size * t / threads;
+    fork ( threads, [&] ( size_t t )
+    {
+        Less copy = less;
+        MinimumHeapIgnorePlacement placed;
+        Element* chunk = elements + bounds[t];
+        size_t length = bounds[t + 1] - bounds[t];
+        Sift::makeHeap ( chunk, length, copy, placed );
+        sortHeap<Pop> ( chunk, length, copy );
+    } );
+
+    // Merges the chunks in pairs, back and forth between the elements and
+    // the buffer, until one run remains.
+    std::vector<Element, Allocator> buffer ( std::make_move_iterator ( elements ),
+                                             std::make_move_iterator ( elements + size ), allocator );
+    Element* from = buffer.data();
+    Element* into = elements;
+    for ( size_t step = 1; step < threads; step *= 2 )
+    {
+        size_t pairs = ( threads + 2 * step - 1 ) / ( 2 * step );
+        fork ( pairs, [&] ( size_t p )
+        {
+            Less copy = less;
+            size_t begin = bounds[2 * step * p];
+            size_t middle = bounds[std::min ( 2 * step * p + step, threads )];
+            size_t end = bounds[std::min ( 2 * step * ( p + 1 ), threads )];
+            std::merge ( std::make_move_iterator ( from + begin ), std::make_move_iterator ( from + middle ),
+                         std::make_move_iterator ( from + middle ), std::make_move_iterator ( from + end ),
+                         into + begin, copy );
+        } );
+        std::swap ( from, into );
+    }
+    if ( from != elements )
+        std::move ( from, from + size, elements );
+}
@@ -0,0 +1,200 @@
+#ifndef MINIMUMHEAPSIFT_H
+#define MINIMUMHEAPSIFT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "minimumheapsimd.h"
+
+/**
+ * The strategies available for restoring the minimum property of a heap after
+ * its top element has been removed.
+ */
+enum class MinimumHeapPop
+{
+    /**
+     * The last element is placed in the hole left at the root and sifted down,
+     * comparing it against the smallest child at each level.
+     */
+    TopDown,
+
+    /**
+     * The hole left at the root is sunk all the way to a leaf along the path of
+     * smallest children, and the last element is then sifted up from that leaf
+     * (Wegener's bottom-up deletemin). Since the last element usually belongs
+     * near the bottom of the heap, this saves roughly one comparison per level
+     * and favours elements with an expensive less than operator.
+     */
+    BottomUp
+};
+
+/**
+ * A placement observer that ignores every placement. Used by containers that
+ * do not need to know where their elements move to.
+ */
+struct MinimumHeapIgnorePlacement
+{
+    constexpr void operator() ( size_t ) const {}
+};
+
+/**
+ * The sift engine shared by the heap containers. Elements are held in an
+ * implicit Arity-ary tree whose root is at index 0 and where the children of
+ * index i are at Arity * i + 1 through Arity * i + Arity.
+ *
+ * Rather than swapping an element with its parent or child at each level, the
+ * engine carries the element being sifted aside and moves a "hole" through the
+ * tree: each element passed over is moved exactly once, into the hole, and the
+ * carried element is moved once into its final position.
+ *
+ * Each time an element is moved into a position the given placement observer
+ * is invoked with that position, which lets addressable containers keep track
+ * of their elements. Containers that do not need this pass
+ * MinimumHeapIgnorePlacement which the compiler removes entirely.
+ *
+ * Every function is constexpr, so that a heap of literal elements can be
+ * built and sifted during constant evaluation (see StaticMinimumHeap); the
+ * vectorised child selection then falls back to the scalar loop.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <size_t Arity> struct MinimumHeapSift {
+
+    static_assert ( Arity >= 2, "MinimumHeapSift requires an Arity of at least 2." );
+
+    /**
+     * Produces the index of the first (left-most) child of the given index.
+     * @param index: the index of the parent element
+     * @return the index of the first child.
+     */
+    static constexpr size_t firstChild ( size_t index );
+
+    /**
+     * Produces the index of the parent of the given index.
+     * @param index: the index of the child element
+     * @return the index of the parent.
+     */
+    static constexpr size_t parent ( size_t index );
+
+    /**
+     * Produces the index of the smallest element among the children in the
+     * index range [first, last). Arithmetic elements ordered by std::less are
+     * compared with vector instructions (see MinimumHeapChildSelect).
+     * @param elements: the elements of the heap.
+     * @param first: the index of the first child.
+     * @param last: one past the index of the last child (last > first).
+     * @param less: the comparison used to order the elements.
+     * @return the index of the smallest child.
+     */
+    template <typename Element, typename Less>
+    static constexpr size_t smallestChild ( const Element* elements, size_t first,
+                                  size_t last, Less& less );
+
+    /**
+     * Moves the hole at the given index up towards (but not above) index top
+     * until the given value can be placed there without violating the minimum
+     * property, then moves the value into the hole.
+     * @param elements: the elements of the heap.
+     * @param top: the index above which the hole will not be moved.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed (moved) into the heap.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     * @return the index at which the value was placed.
+     */
+    template <typename Element, typename Less, typename OnPlace>
+    static constexpr size_t siftUp ( Element* elements, size_t top, size_t hole,
+                           Element&& value, Less& less, OnPlace& placed );
+
+    /**
+     * Moves the element already at the given index up towards (but not above)
+     * index top until the minimum property holds. The element is only moved
+     * out of its slot if it is smaller than its parent (placed is not invoked
+     * if it stays).
+     * @param elements: the elements of the heap.
+     * @param top: the index above which the element will not be moved.
+     * @param index: the index of the element.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     * @return the index at which the element was placed.
+     */
+    template <typename Element, typename Less, typename OnPlace>
+    static constexpr size_t siftUpInPlace ( Element* elements, size_t top, size_t index,
+                                  Less& less, OnPlace& placed );
+
+    /**
+     * Moves the hole at the given index down the heap of the given size until
+     * the given value can be placed there without violating the minimum
+     * property, then moves the value into the hole.
+     * @param elements: the elements of the heap.
+     * @param size: the number of positions in the heap, including the hole.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed (moved) into the heap.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     * @return the index at which the value was placed.
+     */
+    template <typename Element, typename Less, typename OnPlace>
+    static constexpr size_t siftDown ( Element* elements, size_t size, size_t hole,
+                             Element&& value, Less& less, OnPlace& placed );
+
+    /**
+     * Moves the hole at the given index all the way down to a leaf of the heap
+     * of the given size along the path of smallest children, then sifts the
+     * given value back up from that leaf (no higher than the original hole).
+     * @param elements: the elements of the heap.
+     * @param size: the number of positions in the heap, including the hole.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed (moved) into the heap.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     * @return the index at which the value was placed.
+     */
+    template <typename Element, typename Less, typename OnPlace>
+    static constexpr size_t siftDownBottomUp ( Element* elements, size_t size, size_t hole,
+                                     Element&& value, Less& less, OnPlace& placed );
+
+    /**
+     * Fills the hole at the given index with the given value using the given
+     * pop strategy.
+     * @param elements: the elements of the heap.
+     * @param size: the number of positions in the heap, including the hole.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed (moved) into the heap.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     * @return the index at which the value was placed.
+     */
+    template <MinimumHeapPop Pop, typename Element, typename Less, typename OnPlace>
+    static constexpr size_t fillHole ( Element* elements, size_t size, size_t hole,
+                             Element&& value, Less& less, OnPlace& placed );
+
+    /**
+     * Rearranges the given elements into a heap (Floyd's method), sifting down
+     * every parent from the last one to the root.
+     * @param elements: the elements of the heap.
+     * @param size: the number of elements.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     */
+    template <typename Element, typename Less, typename OnPlace>
+    static constexpr void makeHeap ( Element* elements, size_t size, Less& less, OnPlace& placed );
+
+    /**
+     * Sorts the given heap in place into descending order (heapsort): the
+     * top is repeatedly swapped with the last element of the shrinking heap,
+     * whose hole is then filled using the given pop strategy.
+     * @param elements: the elements of the heap.
+     * @param size: the number of elements.
+     * @param less: the comparison used to order the elements.
+     * @param placed: observer invoked with each index an element is moved to.
+     */
+    template <MinimumHeapPop Pop, typename Element, typename Less, typename OnPlace>
+    static constexpr void sortHeap ( Element* elements, size_t size, Less& less, OnPlace& placed );
+
+};
+
+/** Includes the templated implementation to be compiled during usage. **/
+#include "minimumheapsift.tpp"
+
+#endif // MINIMUMHEAPSIFT_H
@@ -0,0 +1,124 @@
+#include "minimumheapsift.h"
+
+template <size_t Arity>
+constexpr size_t MinimumHeapSift<Arity>::firstChild ( size_t index )
+{
+    return Arity * index + 1;
+}
+
+template <size_t Arity>
+constexpr size_t MinimumHeapSift<Arity>::parent ( size_t index )
+{
+    return ( index - 1 ) / Arity;
+}
+
+template <size_t Arity>
+template <typename Element, typename Less>
+constexpr size_t MinimumHeapSift<Arity>::smallestChild ( const Element* elements, size_t first,
+                                                         size_t last, Less& less )
+{
+    return MinimumHeapChildSelect<Element, Less>::smallest ( elements, first, last, less );
+}
+
+template <size_t Arity>
+template <typename Element, typename Less, typename OnPlace>
+constexpr size_t MinimumHeapSift<Arity>::siftUp ( Element* elements, size_t top, size_t hole,
+                                                  Element&& value, Less& less, OnPlace& placed )
+{
+    while ( hole > top )
+    {
+        size_t p = parent ( hole );
+        if ( !less ( value, elements[p] ) )
+            break;
+        elements[hole] = std::move ( elements[p] );
+        placed ( hole );
+        hole = p;
+    }
+    elements[hole] = std::move ( value );
+    placed ( hole );
+    return hole;
+}
+
+template <size_t Arity>
+template <typename Element, typename Less, typename OnPlace>
+constexpr size_t MinimumHeapSift<Arity>::siftUpInPlace ( Element* elements, size_t top, size_t index,
+                                                         Less& less, OnPlace& placed )
+{
+    if ( index > top && less ( elements[index], elements[parent ( index )] ) )
+    {
+        Element value = std::move ( elements[index] );
+        return siftUp ( elements, top, index, std::move ( value ), less, placed );
+    }
+    return index;
+}
+
+template <size_t Arity>
+template <typename Element, typename Less, typename OnPlace>
+constexpr size_t MinimumHeapSift<Arity>::siftDown ( Element* elements, size_t size, size_t hole,
+                                                    Element&& value, Less& less, OnPlace& placed )
+{
+    for ( size_t first = firstChild ( hole ); first < size; first = firstChild ( hole ) )
+    {
+        size_t smallest = smallestChild ( elements, first, std::min ( first + Arity, size ), less );
+        if ( !less ( elements[smallest], value ) )
+            break;
+        elements[hole] = std::move ( elements[smallest] );
+        placed ( hole );
+        hole = smallest;
+    }
+    elements[hole] = std::move ( value );
+    placed ( hole );
+    return hole;
+}
+
+template <size_t Arity>
+template <typename Element, typename Less, typename OnPlace>
+constexpr size_t MinimumHeapSift<Arity>::siftDownBottomUp ( Element* elements, size_t size, size_t hole,
+                                                            Element&& value, Less& less, OnPlace& placed )
+{
+    size_t top = hole;
+    for ( size_t first = firstChild ( hole ); first < size; first = firstChild ( hole ) )
+    {
+        size_t smallest = smallestChild ( elements, first, std::min ( first + Arity, size ), less );
+        elements[hole] = std::move ( elements[smallest] );
+        placed ( hole );
+        hole = smallest;
+    }
+    return siftUp ( elements, top, hole, std::move ( value ), less, placed );
+}
+
+template <size_t Arity>
+template <MinimumHeapPop Pop, typename Element, typename Less, typename OnPlace>
+constexpr size_t MinimumHeapSift<Arity>::fillHole ( Element* elements, size_t size, size_t hole,
+                                                    Element&& value, Less& less, OnPlace& placed )
+{
+    if ( Pop == MinimumHeapPop::BottomUp )
+        return siftDownBottomUp ( elements, size, hole, std::move ( value ), less, placed );
+    return siftDown ( elements, size, hole, std::move ( value ), less, placed );
+}
+
+template <size_t Arity>
+template <typename Element, typename Less, typename OnPlace>
+constexpr void MinimumHeapSift<Arity>::makeHeap ( Element* elements, size_t size, Less& less, OnPlace& placed )
+{
+    if ( size < 2 )
+        return;
+    for ( size_t i = parent ( size - 1 ) + 1; i-- > 0; )
+    {
+        Element value = std::move ( elements[i] );
+        siftDown ( elements, size, i, std::move ( value ), less, placed );
+    }
+}
+
+template <size_t Arity>
+template <MinimumHeapPop Pop, typename Element, typename Less, typename OnPlace>
+constexpr void MinimumHeapSift<Arity>::sortHeap ( Element* elements, size_t size, Less& less, OnPlace& placed )
+{
+    for ( size_t n = size; n > 1; n-- )
+    {
+        Element last = std::move ( elements[n - 1] );
+        elements[n - 1] = std::move ( elements[0] );
+        placed ( n - 1 );
+        fillHole<Pop> ( elements, n - 1, 0, std::move ( last ), less, placed );
+    }
+}
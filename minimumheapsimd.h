@@ -0,0 +1,184 @@
+#ifndef MINIMUMHEAPSIMD_H
+#define MINIMUMHEAPSIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if !defined(MINIMUMHEAP_NO_SIMD) && defined(__x86_64__) && ( defined(__GNUC__) || defined(__clang__) )
+#define MINIMUMHEAP_SIMD_X86 1
+#endif
+
+/** Determines if the enclosing constexpr function is being evaluated as a
+ * constant, where the vectorised kernels cannot run (C++20, or the builtin
+ * offered in C++17 by GCC 9 and Clang 9 onwards). **/
+#if defined(__cpp_lib_is_constant_evaluated)
+#define MINIMUMHEAP_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__clang__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MINIMUMHEAP_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#define MINIMUMHEAP_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#ifndef MINIMUMHEAP_CONSTANT_EVALUATED
+#define MINIMUMHEAP_CONSTANT_EVALUATED() false
+#endif
+
+/**
+ * Vectorised kernels which find the smallest of a group of contiguous
+ * arithmetic keys, used by the sift engine to pick the smallest child when the
+ * children of an element are 32-bit or 64-bit signed integers, floats or
+ * doubles ordered by std::less.
+ *
+ * The instruction set is chosen at run time from the features of the CPU
+ * (AVX2, then SSE4.1, then a scalar loop) so a single binary runs on every
+ * x86-64 host. The kernels pay off for wide heaps, where each group of
+ * children is 8 or 16 keys long (see MinimumHeapCacheLineArity); groups of
+ * fewer than 8 children are always compared by the scalar loop.
+ *
+ * Defining MINIMUMHEAP_NO_SIMD, or compiling for anything other than x86-64
+ * with GCC or Clang, leaves only the scalar loop.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+class MinimumHeapSimd {
+
+    /**
+     * Produces the index of the first smallest of the given keys one key at
+     * a time.
+     * @param keys: the keys to search.
+     * @param count: the number of keys (count > 0).
+     * @return the index of the smallest key.
+     */
+    template <typename Key>
+    static size_t scalarSmallest ( const Key* keys, size_t count );
+
+    /**
+     * Produces the index of the first smallest of the keys in [from, count)
+     * that are smaller than the given minimum, one key at a time. Used for
+     * the keys left over after the last full vector.
+     * @param keys: the keys to search.
+     * @param from: the index of the first key to search.
+     * @param count: the number of keys.
+     * @param minimum: the smallest key found so far.
+     * @return the index of the smallest key, or count if none is smaller.
+     */
+    template <typename Key>
+    static size_t scalarTail ( const Key* keys, size_t from, size_t count, Key minimum );
+
+#ifdef MINIMUMHEAP_SIMD_X86
+    /** The SSE4.1 kernels. **/
+    static size_t sse41Smallest ( const int32_t* keys, size_t count );
+    static size_t sse41Smallest ( const float* keys, size_t count );
+    static size_t sse41Smallest ( const double* keys, size_t count );
+
+    /** The AVX2 kernels. **/
+    static size_t avx2Smallest ( const int32_t* keys, size_t count );
+    static size_t avx2Smallest ( const int64_t* keys, size_t count );
+    static size_t avx2Smallest ( const float* keys, size_t count );
+    static size_t avx2Smallest ( const double* keys, size_t count );
+#endif
+
+public:
+
+    /** The instruction sets the kernels are available for. **/
+    enum Level { Scalar, SSE41, AVX2 };
+
+    /**
+     * Produces the best instruction set supported by the CPU (detected once).
+     * @return the instruction set used by the dispatched kernels.
+     */
+    static Level level ( );
+
+    /**
+     * Produces the index of the (first) smallest of the given keys using the
+     * best instruction set supported by the CPU.
+     * @param keys: the keys to search.
+     * @param count: the number of keys (count > 0).
+     * @return the index of the smallest key, from 0 to count - 1.
+     */
+    static size_t smallest ( const int32_t* keys, size_t count );
+    static size_t smallest ( const int64_t* keys, size_t count );
+    static size_t smallest ( const float* keys, size_t count );
+    static size_t smallest ( const double* keys, size_t count );
+
+    /**
+     * Produces the index of the (first) smallest of the given keys using the
+     * given instruction set, which must be supported by the CPU.
+     * @param keys: the keys to search.
+     * @param count: the number of keys (count > 0).
+     * @param level: the instruction set to use.
+     * @return the index of the smallest key, from 0 to count - 1.
+     */
+    static size_t smallest ( const int32_t* keys, size_t count, Level level );
+    static size_t smallest ( const int64_t* keys, size_t count, Level level );
+    static size_t smallest ( const float* keys, size_t count, Level level );
+    static size_t smallest ( const double* keys, size_t count, Level level );
+
+};
+
+/**
+ * Maps the element types with a vectorised kernel to the key type of the
+ * kernel: 32-bit and 64-bit signed integers (whatever their spelling), float
+ * and double. Other element types are not vectorised.
+ */
+template <typename Element, typename Enable = void>
+struct MinimumHeapSimdKey {
+    static constexpr bool value = false;
+};
+
+template <typename Element>
+struct MinimumHeapSimdKey<Element, typename std::enable_if<
+        std::is_integral<Element>::value && std::is_signed<Element>::value
+        && ( sizeof(Element) == 4 || sizeof(Element) == 8 )>::type> {
+    static constexpr bool value = true;
+    typedef typename std::conditional<sizeof(Element) == 4, int32_t, int64_t>::type Key;
+};
+
+template <> struct MinimumHeapSimdKey<float> {
+    static constexpr bool value = true;
+    typedef float Key;
+};
+
+template <> struct MinimumHeapSimdKey<double> {
+    static constexpr bool value = true;
+    typedef double Key;
+};
+
+/**
+ * Selects the smallest of a group of children for the sift engine. The general
+ * case compares the children one at a time with the given comparison; element
+ * types with a vectorised kernel that are ordered by std::less use the kernel,
+ * except during constant evaluation (where the compiler cannot tell, only
+ * groups of fewer than 8 children can be selected then).
+ */
+template <typename Element, typename Less, typename Enable = void>
+struct MinimumHeapChildSelect {
+
+    /**
+     * Produces the index of the smallest element in the range [first, last).
+     * @param elements: the elements of the heap.
+     * @param first: the index of the first child.
+     * @param last: one past the index of the last child (last > first).
+     * @param less: the comparison used to order the elements.
+     * @return the index of the smallest child.
+     */
+    static constexpr size_t smallest ( const Element* elements, size_t first, size_t last, Less& less );
+
+};
+
+template <typename Element>
+struct MinimumHeapChildSelect<Element, std::less<Element>,
+        typename std::enable_if<MinimumHeapSimdKey<Element>::value>::type> {
+
+    static constexpr size_t smallest ( const Element* elements, size_t first, size_t last,
+                                       std::less<Element>& less );
+
+};
+
+/** Includes the implementation to be compiled during usage. **/
+#include "minimumheapsimd.tpp"
+
+#endif // MINIMUMHEAPSIMD_H
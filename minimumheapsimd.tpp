@@ -0,0 +1,315 @@
+#include "minimumheapsimd.h"
+
+#ifdef MINIMUMHEAP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+template <typename Key>
+size_t MinimumHeapSimd::scalarSmallest ( const Key* keys, size_t count )
+{
+    size_t smallest = 0;
+    for ( size_t i = 1; i < count; i++ )
+    {
+        if ( keys[i] < keys[smallest] )
+            smallest = i;
+    }
+    return smallest;
+}
+
+template <typename Key>
+size_t MinimumHeapSimd::scalarTail ( const Key* keys, size_t from, size_t count, Key minimum )
+{
+    size_t smallest = count;
+    for ( size_t i = from; i < count; i++ )
+    {
+        if ( keys[i] < minimum )
+        {
+            minimum = keys[i];
+            smallest = i;
+        }
+    }
+    return smallest;
+}
+
+#ifdef MINIMUMHEAP_SIMD_X86
+
+__attribute__(( target("sse4.1") ))
+inline size_t MinimumHeapSimd::sse41Smallest ( const int32_t* keys, size_t count )
+{
+    if ( count < 4 ) { return scalarSmallest ( keys, count ); }
+    __m128i m = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( keys ) );
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 )
+        m = _mm_min_epi32 ( m, _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( keys + i ) ) );
+    m = _mm_min_epi32 ( m, _mm_shuffle_epi32 ( m, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    m = _mm_min_epi32 ( m, _mm_shuffle_epi32 ( m, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+    int32_t minimum = _mm_cvtsi128_si32 ( m );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m128i target = _mm_set1_epi32 ( minimum );
+    for ( size_t k = 0; k < i; k += 4 )
+    {
+        __m128i eq = _mm_cmpeq_epi32 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( keys + k ) ), target );
+        int mask = _mm_movemask_ps ( _mm_castsi128_ps ( eq ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("sse4.1") ))
+inline size_t MinimumHeapSimd::sse41Smallest ( const float* keys, size_t count )
+{
+    if ( count < 4 ) { return scalarSmallest ( keys, count ); }
+    __m128 m = _mm_loadu_ps ( keys );
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 )
+        m = _mm_min_ps ( m, _mm_loadu_ps ( keys + i ) );
+    m = _mm_min_ps ( m, _mm_shuffle_ps ( m, m, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    m = _mm_min_ps ( m, _mm_shuffle_ps ( m, m, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+    float minimum = _mm_cvtss_f32 ( m );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m128 target = _mm_set1_ps ( minimum );
+    for ( size_t k = 0; k < i; k += 4 )
+    {
+        int mask = _mm_movemask_ps ( _mm_cmpeq_ps ( _mm_loadu_ps ( keys + k ), target ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("sse4.1") ))
+inline size_t MinimumHeapSimd::sse41Smallest ( const double* keys, size_t count )
+{
+    if ( count < 4 ) { return scalarSmallest ( keys, count ); }
+    __m128d m = _mm_loadu_pd ( keys );
+    size_t i = 2;
+    for ( ; i + 2 <= count; i += 2 )
+        m = _mm_min_pd ( m, _mm_loadu_pd ( keys + i ) );
+    m = _mm_min_pd ( m, _mm_shuffle_pd ( m, m, 1 ) );
+    double minimum = _mm_cvtsd_f64 ( m );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m128d target = _mm_set1_pd ( minimum );
+    for ( size_t k = 0; k < i; k += 2 )
+    {
+        int mask = _mm_movemask_pd ( _mm_cmpeq_pd ( _mm_loadu_pd ( keys + k ), target ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("avx2") ))
+inline size_t MinimumHeapSimd::avx2Smallest ( const int32_t* keys, size_t count )
+{
+    if ( count < 8 ) { return sse41Smallest ( keys, count ); }
+    __m256i m = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys ) );
+    size_t i = 8;
+    for ( ; i + 8 <= count; i += 8 )
+        m = _mm256_min_epi32 ( m, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys + i ) ) );
+    __m128i r = _mm_min_epi32 ( _mm256_castsi256_si128 ( m ), _mm256_extracti128_si256 ( m, 1 ) );
+    r = _mm_min_epi32 ( r, _mm_shuffle_epi32 ( r, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    r = _mm_min_epi32 ( r, _mm_shuffle_epi32 ( r, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+    int32_t minimum = _mm_cvtsi128_si32 ( r );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m256i target = _mm256_set1_epi32 ( minimum );
+    for ( size_t k = 0; k < i; k += 8 )
+    {
+        __m256i eq = _mm256_cmpeq_epi32 ( _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys + k ) ), target );
+        int mask = _mm256_movemask_ps ( _mm256_castsi256_ps ( eq ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("avx2") ))
+inline size_t MinimumHeapSimd::avx2Smallest ( const int64_t* keys, size_t count )
+{
+    if ( count < 4 ) { return scalarSmallest ( keys, count ); }
+    __m256i m = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys ) );
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m256i next = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys + i ) );
+        m = _mm256_blendv_epi8 ( m, next, _mm256_cmpgt_epi64 ( m, next ) );
+    }
+    __m256i t = _mm256_permute4x64_epi64 ( m, _MM_SHUFFLE ( 1, 0, 3, 2 ) );
+    m = _mm256_blendv_epi8 ( m, t, _mm256_cmpgt_epi64 ( m, t ) );
+    t = _mm256_shuffle_epi32 ( m, _MM_SHUFFLE ( 1, 0, 3, 2 ) );
+    m = _mm256_blendv_epi8 ( m, t, _mm256_cmpgt_epi64 ( m, t ) );
+    int64_t minimum = _mm_cvtsi128_si64 ( _mm256_castsi256_si128 ( m ) );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m256i target = _mm256_set1_epi64x ( minimum );
+    for ( size_t k = 0; k < i; k += 4 )
+    {
+        __m256i eq = _mm256_cmpeq_epi64 ( _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( keys + k ) ), target );
+        int mask = _mm256_movemask_pd ( _mm256_castsi256_pd ( eq ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("avx2") ))
+inline size_t MinimumHeapSimd::avx2Smallest ( const float* keys, size_t count )
+{
+    if ( count < 8 ) { return sse41Smallest ( keys, count ); }
+    __m256 m = _mm256_loadu_ps ( keys );
+    size_t i = 8;
+    for ( ; i + 8 <= count; i += 8 )
+        m = _mm256_min_ps ( m, _mm256_loadu_ps ( keys + i ) );
+    __m128 r = _mm_min_ps ( _mm256_castps256_ps128 ( m ), _mm256_extractf128_ps ( m, 1 ) );
+    r = _mm_min_ps ( r, _mm_shuffle_ps ( r, r, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    r = _mm_min_ps ( r, _mm_shuffle_ps ( r, r, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+    float minimum = _mm_cvtss_f32 ( r );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m256 target = _mm256_set1_ps ( minimum );
+    for ( size_t k = 0; k < i; k += 8 )
+    {
+        int mask = _mm256_movemask_ps ( _mm256_cmp_ps ( _mm256_loadu_ps ( keys + k ), target, _CMP_EQ_OQ ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+__attribute__(( target("avx2") ))
+inline size_t MinimumHeapSimd::avx2Smallest ( const double* keys, size_t count )
+{
+    if ( count < 4 ) { return scalarSmallest ( keys, count ); }
+    __m256d m = _mm256_loadu_pd ( keys );
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 )
+        m = _mm256_min_pd ( m, _mm256_loadu_pd ( keys + i ) );
+    __m128d r = _mm_min_pd ( _mm256_castpd256_pd128 ( m ), _mm256_extractf128_pd ( m, 1 ) );
+    r = _mm_min_pd ( r, _mm_shuffle_pd ( r, r, 1 ) );
+    double minimum = _mm_cvtsd_f64 ( r );
+
+    size_t tail = scalarTail ( keys, i, count, minimum );
+    if ( tail < count ) { return tail; }
+    __m256d target = _mm256_set1_pd ( minimum );
+    for ( size_t k = 0; k < i; k += 4 )
+    {
+        int mask = _mm256_movemask_pd ( _mm256_cmp_pd ( _mm256_loadu_pd ( keys + k ), target, _CMP_EQ_OQ ) );
+        if ( mask ) { return k + __builtin_ctz ( mask ); }
+    }
+    return scalarSmallest ( keys, count );
+}
+
+#endif // MINIMUMHEAP_SIMD_X86
+
+inline MinimumHeapSimd::Level MinimumHeapSimd::level ( )
+{
+#ifdef MINIMUMHEAP_SIMD_X86
+    static const Level detected = [] {
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports ( "avx2" ) ) { return AVX2; }
+        if ( __builtin_cpu_supports ( "sse4.1" ) ) { return SSE41; }
+        return Scalar;
+    } ();
+    return detected;
+#else
+    return Scalar;
+#endif
+}
+
+inline size_t MinimumHeapSimd::smallest ( const int32_t* keys, size_t count, Level level )
+{
+#ifdef MINIMUMHEAP_SIMD_X86
+    if ( level == AVX2 ) { return avx2Smallest ( keys, count ); }
+    if ( level == SSE41 ) { return sse41Smallest ( keys, count ); }
+#endif
+    (void) level;
+    return scalarSmallest ( keys, count );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const int64_t* keys, size_t count, Level level )
+{
+#ifdef MINIMUMHEAP_SIMD_X86
+    if ( level == AVX2 ) { return avx2Smallest ( keys, count ); }
+#endif
+    (void) level;
+    return scalarSmallest ( keys, count );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const float* keys, size_t count, Level level )
+{
+#ifdef MINIMUMHEAP_SIMD_X86
+    if ( level == AVX2 ) { return avx2Smallest ( keys, count ); }
+    if ( level == SSE41 ) { return sse41Smallest ( keys, count ); }
+#endif
+    (void) level;
+    return scalarSmallest ( keys, count );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const double* keys, size_t count, Level level )
+{
+#ifdef MINIMUMHEAP_SIMD_X86
+    if ( level == AVX2 ) { return avx2Smallest ( keys, count ); }
+    if ( level == SSE41 ) { return sse41Smallest ( keys, count ); }
+#endif
+    (void) level;
+    return scalarSmallest ( keys, count );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const int32_t* keys, size_t count )
+{
+    return smallest ( keys, count, level() );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const int64_t* keys, size_t count )
+{
+    return smallest ( keys, count, level() );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const float* keys, size_t count )
+{
+    return smallest ( keys, count, level() );
+}
+
+inline size_t MinimumHeapSimd::smallest ( const double* keys, size_t count )
+{
+    return smallest ( keys, count, level() );
+}
+
+template <typename Element, typename Less, typename Enable>
+constexpr size_t MinimumHeapChildSelect<Element, Less, Enable>::smallest ( const Element* elements, size_t first,
+                                                                           size_t last, Less& less )
+{
+    size_t smallest = first;
+    for ( size_t c = first + 1; c < last; c++ )
+    {
+        if ( less ( elements[c], elements[smallest] ) )
+            smallest = c;
+    }
+    return smallest;
+}
+
+template <typename Element>
+constexpr size_t MinimumHeapChildSelect<Element, std::less<Element>,
+        typename std::enable_if<MinimumHeapSimdKey<Element>::value>::type>::smallest (
+                const Element* elements, size_t first, size_t last, std::less<Element>& less )
+{
+    // Below two vectors' worth of children the call into the kernel costs
+    // more than the comparisons it saves.
+    if ( last - first < 8 || MINIMUMHEAP_CONSTANT_EVALUATED() )
+    {
+        size_t smallest = first;
+        for ( size_t c = first + 1; c < last; c++ )
+        {
+            if ( less ( elements[c], elements[smallest] ) )
+                smallest = c;
+        }
+        return smallest;
+    }
+    typedef typename MinimumHeapSimdKey<Element>::Key Key;
+    return first + MinimumHeapSimd::smallest ( reinterpret_cast<const Key*> ( elements + first ),
+                                               last - first );
+}
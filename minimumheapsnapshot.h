@@ -0,0 +1,132 @@
+#ifndef MINIMUMHEAPSNAPSHOT_H
+#define MINIMUMHEAPSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Exception: A heap snapshot could not be written, read or mapped, or
+ * it does not match the heap it is loaded into (see MinimumHeapSnapshotHeader).
+ */
+class MinimumHeapSnapshotException {};
+
+/**
+ * The header of a binary heap snapshot, written by MinimumHeap::save and read
+ * by MinimumHeap::load and MappedMinimumHeap.
+ *
+ * A snapshot is this 64-byte header followed by the count elements of the heap
+ * as raw bytes, already in heap order, so that loading it needs no sift at all
+ * and a memory mapping of the file can be used as the heap in place. Only
+ * trivially copyable elements can be saved. The header records what a reader
+ * must agree with: the format version, the byte order, the Arity of the heap
+ * and the size of an element; the checksum guards the elements against
+ * truncation and corruption. The ordering of the elements (Compare) is not
+ * recorded: a snapshot must be read with the ordering it was written with.
+ * Elements start 64 bytes into the file, so they are suitably aligned in a
+ * mapping for any element type with an alignment of up to 64.
+ */
+struct MinimumHeapSnapshotHeader {
+
+    /** The current version of the format. **/
+    static constexpr uint32_t Version = 2;
+
+    /** Written as is: reads back differently on a host of the other byte order. **/
+    static constexpr uint32_t ByteOrder = 0x01020304;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t arity;
+    uint32_t elementSize;
+    uint64_t count;
+    uint64_t checksum;
+    unsigned char reserved[24];
+
+    /**
+     * Produces the header of a snapshot of the given elements.
+     * @param arity: the Arity of the heap.
+     * @param elementSize: the size of an element in bytes.
+     * @param elements: the elements of the heap.
+     * @param count: the number of elements.
+     */
+    static MinimumHeapSnapshotHeader make ( size_t arity, size_t elementSize,
+                                            const void* elements, size_t count )
+    {
+        MinimumHeapSnapshotHeader header;
+        std::memset ( &header, 0, sizeof header );
+        std::memcpy ( header.magic, "MINHEAP", 8 );
+        header.version = Version;
+        header.byteOrder = ByteOrder;
+        header.arity = static_cast<uint32_t> ( arity );
+        header.elementSize = static_cast<uint32_t> ( elementSize );
+        header.count = count;
+        header.checksum = hash ( elements, count * elementSize );
+        return header;
+    }
+
+    /**
+     * Determines if this header describes a snapshot which can be read into a
+     * heap of the given Arity and element size (the checksum is not verified).
+     * @return true if the header matches, false otherwise.
+     */
+    bool matches ( size_t arity, size_t elementSize ) const
+    {
+        return std::memcmp ( magic, "MINHEAP", 8 ) == 0 && version == Version
+               && byteOrder == ByteOrder && this->arity == arity
+               && this->elementSize == elementSize;
+    }
+
+    /**
+     * Produces the checksum of the given bytes (the checksum field), taken over
+     * 8-byte words (the last word padded with zeros) with the lane round and
+     * final avalanche of xxHash64, which runs at memory speed for large heaps.
+     * Each word is mixed before it is folded in, so flipping the same bits of
+     * several words does not cancel out.
+     * @param data: the bytes to checksum.
+     * @param bytes: the number of bytes.
+     * @return the checksum.
+     */
+    static uint64_t hash ( const void* data, size_t bytes )
+    {
+        const unsigned char* p = static_cast<const unsigned char*> ( data );
+        uint64_t result = 0x27D4EB2F165667C5ull + bytes;
+        for ( ; bytes >= 8; p += 8, bytes -= 8 )
+        {
+            uint64_t word;
+            std::memcpy ( &word, p, 8 );
+            result = fold ( result, word );
+        }
+        if ( bytes > 0 )
+        {
+            uint64_t word = 0;
+            std::memcpy ( &word, p, bytes );
+            result = fold ( result, word );
+        }
+        result ^= result >> 33;
+        result *= 0xC2B2AE3D27D4EB4Full;
+        result ^= result >> 29;
+        result *= 0x165667B19E3779F9ull;
+        result ^= result >> 32;
+        return result;
+    }
+
+private:
+
+    static uint64_t rotl ( uint64_t x, int r )
+    {
+        return ( x << r ) | ( x >> ( 64 - r ) );
+    }
+
+    /** Mixes the given word and folds it into the checksum so far. **/
+    static uint64_t fold ( uint64_t result, uint64_t word )
+    {
+        word = rotl ( word * 0xC2B2AE3D27D4EB4Full, 31 ) * 0x9E3779B185EBCA87ull;
+        return rotl ( result ^ word, 27 ) * 0x9E3779B185EBCA87ull + 0x85EBCA77C2B2AE63ull;
+    }
+};
+
+static_assert ( sizeof ( MinimumHeapSnapshotHeader ) == 64,
+                "MinimumHeapSnapshotHeader must be 64 bytes." );
+
+#endif // MINIMUMHEAPSNAPSHOT_H
@@ -0,0 +1,218 @@
+#ifndef MINIMUMHEAPSORTED_H
+#define MINIMUMHEAPSORTED_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+#include "minimumheapsift.h"
+
+/**
+ * A forward iterator over the elements of a heap in ascending order, which
+ * leaves the heap untouched (see MinimumHeap::sorted).
+ *
+ * The smallest element not yet produced is always a child of one already
+ * produced, so the iterator keeps the indices of those candidates (the
+ * frontier) in a small binary heap of its own, ordered by the elements they
+ * index: advancing replaces the index produced with its children. Producing
+ * the first k elements therefore costs O(k log k), whatever the size of the
+ * heap, and the frontier holds at most k * (Arity - 1) + 1 indices. Copying
+ * the iterator copies its frontier.
+ *
+ * The iterator refers to the elements of the heap, which must not change
+ * while it is in use.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity, typename Compare>
+class MinimumHeapSortedIterator {
+
+    /** Orders indices by the elements they index. **/
+    struct IndexLess {
+        const Comparable* elements;
+        const Compare* compare;
+        bool operator() ( size_t lhs, size_t rhs ) const { return ( *compare ) ( elements[lhs], elements[rhs] ); }
+    };
+
+    /** The sift engine of the frontier. **/
+    typedef MinimumHeapSift<2> Sift;
+
+    /** The elements of the heap. **/
+    const Comparable* _elements = nullptr;
+
+    /** The number of elements in the heap. **/
+    size_t _size = 0;
+
+    /** The function object used to order the elements. **/
+    Compare _compare {};
+
+    /** The indices of the candidates for the next element, as a heap. **/
+    std::vector<size_t> _frontier;
+
+    /** The number of elements produced so far. **/
+    size_t _taken = 0;
+
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Comparable value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Comparable* pointer;
+    typedef const Comparable& reference;
+
+    /** Instantiate the iterator past the end of an empty heap. **/
+    MinimumHeapSortedIterator ( ) = default;
+
+    /**
+     * Instantiate an iterator at the smallest element of the given heap, or
+     * past its end.
+     * @param elements: the elements of the heap.
+     * @param size: the number of elements in the heap.
+     * @param compare: the function object used to order the elements.
+     * @param end: true for the iterator past the end.
+     */
+    MinimumHeapSortedIterator ( const Comparable* elements, size_t size, const Compare& compare, bool end );
+
+    /** Produces the current element. **/
+    reference operator* ( ) const { return _elements[_frontier[0]]; }
+    pointer operator-> ( ) const { return &_elements[_frontier[0]]; }
+
+    /** Advances to the next larger element (in O(log k) after k elements). **/
+    MinimumHeapSortedIterator& operator++ ( );
+    MinimumHeapSortedIterator operator++ ( int );
+
+    /** Iterators over the same heap are equal at the same element. **/
+    bool operator== ( const MinimumHeapSortedIterator& rhs ) const { return _taken == rhs._taken; }
+    bool operator!= ( const MinimumHeapSortedIterator& rhs ) const { return _taken != rhs._taken; }
+};
+
+/**
+ * The elements of a heap in ascending order, produced lazily by a
+ * MinimumHeapSortedIterator (see MinimumHeap::sorted). A view: it refers to
+ * the elements of the heap, and is copied in O(1).
+ */
+template <typename Comparable, size_t Arity, typename Compare>
+class MinimumHeapSortedRange {
+
+    const Comparable* _elements = nullptr;
+    size_t _size = 0;
+    Compare _compare {};
+
+public:
+
+    typedef MinimumHeapSortedIterator<Comparable, Arity, Compare> iterator;
+    typedef iterator const_iterator;
+
+    MinimumHeapSortedRange ( ) = default;
+    MinimumHeapSortedRange ( const Comparable* elements, size_t size, const Compare& compare )
+        : _elements { elements }, _size { size }, _compare { compare } {}
+
+    iterator begin ( ) const { return iterator ( _elements, _size, _compare, false ); }
+    iterator end ( ) const { return iterator ( _elements, _size, _compare, true ); }
+    size_t size ( ) const { return _size; }
+    bool empty ( ) const { return _size == 0; }
+};
+
+/**
+ * The elements of a heap in ascending order, removed from it lazily (see
+ * MinimumHeap::drain_sorted).
+ *
+ * Advancing the iterator runs one step of an in-place heapsort on the
+ * underlying vector of the heap: the top is moved to the last slot of the
+ * shrinking heap (no element leaves the buffer, and none is copied) and the
+ * hole is refilled using the Pop strategy. The current element can be moved
+ * from. When the range is destroyed the elements iterated past are erased
+ * from the vector, and the heap holds the rest: draining the first k elements
+ * costs O(k log n).
+ *
+ * The range is an input range and cannot be copied; the heap must not be used
+ * while it exists.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+class MinimumHeapDrainRange {
+
+    /** The underlying vector of the heap (null once moved from). **/
+    std::vector<Comparable, Allocator>* _elements;
+
+    /** The number of elements still in the heap, at the front of the vector. **/
+    size_t _size;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Moves the top of the heap to the slot past the heap and refills the
+     * hole (one step of heapsort).
+     */
+    void advance ( );
+
+public:
+
+    /** Produces the remaining elements of the heap, smallest first. **/
+    class iterator {
+        friend class MinimumHeapDrainRange;
+        MinimumHeapDrainRange* _range = nullptr;
+        explicit iterator ( MinimumHeapDrainRange* range ) : _range { range } {}
+        bool done ( ) const { return _range == nullptr || _range->_size == 0; }
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Comparable value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Comparable* pointer;
+        typedef Comparable& reference;
+
+        iterator ( ) = default;
+        reference operator* ( ) const { return ( *_range->_elements )[0]; }
+        pointer operator-> ( ) const { return &( *_range->_elements )[0]; }
+        iterator& operator++ ( ) { _range->advance(); return *this; }
+        void operator++ ( int ) { _range->advance(); }
+        bool operator== ( const iterator& rhs ) const { return done() == rhs.done(); }
+        bool operator!= ( const iterator& rhs ) const { return done() != rhs.done(); }
+    };
+
+    /**
+     * Instantiate the range draining the given underlying vector of a heap.
+     * @param elements: the elements of the heap.
+     * @param compare: the function object used to order the elements.
+     */
+    MinimumHeapDrainRange ( std::vector<Comparable, Allocator>& elements, const Compare& compare );
+
+    MinimumHeapDrainRange ( const MinimumHeapDrainRange& rhs ) = delete;
+    MinimumHeapDrainRange& operator= ( const MinimumHeapDrainRange& rhs ) = delete;
+    MinimumHeapDrainRange ( MinimumHeapDrainRange&& rhs ) noexcept;
+    MinimumHeapDrainRange& operator= ( MinimumHeapDrainRange&& rhs ) noexcept;
+
+    /** Erases the elements iterated past from the heap. **/
+    ~MinimumHeapDrainRange ( );
+
+    iterator begin ( ) { return iterator ( this ); }
+    iterator end ( ) { return iterator(); }
+
+    /** Produces the number of elements not yet iterated past. **/
+    size_t size ( ) const { return _size; }
+    bool empty ( ) const { return _size == 0; }
+};
+
+#if defined(__cpp_lib_ranges)
+/** A MinimumHeapSortedRange is a view whose iterators refer to the heap, not
+ * to the range. **/
+template <typename Comparable, size_t Arity, typename Compare>
+inline constexpr bool std::ranges::enable_view<MinimumHeapSortedRange<Comparable, Arity, Compare>> = true;
+template <typename Comparable, size_t Arity, typename Compare>
+inline constexpr bool std::ranges::enable_borrowed_range<MinimumHeapSortedRange<Comparable, Arity, Compare>> = true;
+#endif
+
+/** Includes the templated implementation to be compiled during usage. **/
+#include "minimumheapsorted.tpp"
+
+#endif // MINIMUMHEAPSORTED_H
@@ -0,0 +1,88 @@
+#include "minimumheapsorted.h"
+
+template <typename Comparable, size_t Arity, typename Compare>
+MinimumHeapSortedIterator<Comparable, Arity, Compare>::MinimumHeapSortedIterator (
+        const Comparable* elements, size_t size, const Compare& compare, bool end )
+    : _elements { elements }, _size { size }, _compare { compare }, _taken { end ? size : 0 }
+{
+    if ( !end && size > 0 )
+        _frontier.push_back ( 0 );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+MinimumHeapSortedIterator<Comparable, Arity, Compare>& MinimumHeapSortedIterator<Comparable, Arity, Compare>::operator++ ( )
+{
+    IndexLess less { _elements, &_compare };
+    MinimumHeapIgnorePlacement placed;
+    size_t first = Arity * _frontier[0] + 1;
+    _taken++;
+    if ( first < _size )
+    {
+        // The first child takes the place of its parent, the others join.
+        Sift::siftDown ( _frontier.data(), _frontier.size(), 0, size_t ( first ), less, placed );
+        for ( size_t child = first + 1; child < first + Arity && child < _size; child++ )
+        {
+            _frontier.push_back ( child );
+            Sift::siftUpInPlace ( _frontier.data(), 0, _frontier.size() - 1, less, placed );
+        }
+    }
+    else
+    {
+        size_t last = _frontier.back();
+        _frontier.pop_back();
+        if ( !_frontier.empty() )
+            Sift::siftDown ( _frontier.data(), _frontier.size(), 0, std::move ( last ), less, placed );
+    }
+    return *this;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+MinimumHeapSortedIterator<Comparable, Arity, Compare> MinimumHeapSortedIterator<Comparable, Arity, Compare>::operator++ ( int )
+{
+    MinimumHeapSortedIterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+void MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>::advance ( )
+{
+    Comparable* elements = _elements->data();
+    size_t last = --_size;
+    if ( last == 0 )
+        return;
+    MinimumHeapIgnorePlacement placed;
+    Comparable value = std::move ( elements[last] );
+    elements[last] = std::move ( elements[0] );
+    MinimumHeapSift<Arity>::template fillHole<Pop> ( elements, last, 0, std::move ( value ), _compare, placed );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>::MinimumHeapDrainRange (
+        std::vector<Comparable, Allocator>& elements, const Compare& compare )
+    : _elements { &elements }, _size { elements.size() }, _compare { compare } {}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>::MinimumHeapDrainRange (
+        MinimumHeapDrainRange&& rhs ) noexcept
+    : _elements { rhs._elements }, _size { rhs._size }, _compare { std::move ( rhs._compare ) }
+{
+    rhs._elements = nullptr;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>&
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>::operator= ( MinimumHeapDrainRange&& rhs ) noexcept
+{
+    std::swap ( _elements, rhs._elements );
+    std::swap ( _size, rhs._size );
+    std::swap ( _compare, rhs._compare );
+    return *this;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare, typename Allocator>
+MinimumHeapDrainRange<Comparable, Arity, Pop, Compare, Allocator>::~MinimumHeapDrainRange ( )
+{
+    if ( _elements != nullptr )
+        _elements->erase ( _elements->begin() + _size, _elements->end() );
+}
@@ -0,0 +1,185 @@
+#ifndef MINIMUMHEAPSTATS_H
+#define MINIMUMHEAPSTATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <iostream>
+
+/**
+ * Statistics policy of a MinimumHeap which records nothing (the default).
+ * Every hook is empty and the comparison and placement observers it selects
+ * are the plain ones, so the compiler removes the instrumentation entirely.
+ */
+struct MinimumHeapNoStats {
+
+    static constexpr bool enabled = false;
+
+    void compared ( ) { }
+    void moved ( ) { }
+    void siftedUp ( size_t ) { }
+    void siftedDown ( size_t ) { }
+    void rebuilt ( ) { }
+    void reallocated ( ) { }
+    void resized ( size_t ) { }
+};
+
+/**
+ * Statistics policy of a MinimumHeap which counts the work the heap does:
+ *
+ *  - comparisons: the calls made to the Compare function object;
+ *  - moves: the elements moved (or constructed) into a slot of the heap;
+ *  - siftUpDepths / siftDownDepths: histograms of the number of levels each
+ *    sift moved an element by (index d counts sifts of depth d, the last
+ *    index counts every deeper sift); pop with the BottomUp strategy records
+ *    the length of the whole path its hole travelled down and back up;
+ *  - rebuilds: the linear time rebuilds of the whole heap (construction from a
+ *    vector, large insert_range or merge), whose sifts are not in the
+ *    histograms;
+ *  - reallocations: the times the underlying vector moved to a new buffer
+ *    after construction;
+ *  - peakSize: the largest number of elements held at once.
+ *
+ * A rising average sift up depth, for example, shows insert receiving keys in
+ * descending order, and a rising number of reallocations a heap which should
+ * be reserved.
+ */
+struct MinimumHeapStats {
+
+    static constexpr bool enabled = true;
+
+    /** The number of buckets of the depth histograms. **/
+    static constexpr size_t Depths = 64;
+
+    uint64_t comparisons = 0;
+    uint64_t moves = 0;
+    std::array<uint64_t, Depths> siftUpDepths {};
+    std::array<uint64_t, Depths> siftDownDepths {};
+    uint64_t rebuilds = 0;
+    uint64_t reallocations = 0;
+    size_t peakSize = 0;
+
+    void compared ( ) { comparisons++; }
+    void moved ( ) { moves++; }
+    void siftedUp ( size_t depth ) { siftUpDepths[depth < Depths ? depth : Depths - 1]++; }
+    void siftedDown ( size_t depth ) { siftDownDepths[depth < Depths ? depth : Depths - 1]++; }
+    void rebuilt ( ) { rebuilds++; }
+    void reallocated ( ) { reallocations++; }
+    void resized ( size_t size ) { if ( size > peakSize ) peakSize = size; }
+
+    /**
+     * Resets every count to zero, e.g. after exporting them.
+     */
+    void reset ( )
+    {
+        *this = MinimumHeapStats();
+    }
+
+    /**
+     * Produces the counts to the given output stream, as "MinimumHeapStats
+     * [comparisons: c, moves: m, ...]", each histogram being listed up to its
+     * last non-zero depth.
+     * @param out: the output stream to be updated.
+     */
+    void output ( std::ostream& out = std::cout ) const
+    {
+        out << "MinimumHeapStats [comparisons: " << comparisons << ", moves: " << moves
+            << ", sift up depths: ";
+        outputDepths ( out, siftUpDepths );
+        out << ", sift down depths: ";
+        outputDepths ( out, siftDownDepths );
+        out << ", rebuilds: " << rebuilds << ", reallocations: " << reallocations
+            << ", peak size: " << peakSize << "]";
+        out.flush();
+    }
+
+private:
+
+    static void outputDepths ( std::ostream& out, const std::array<uint64_t, Depths>& depths )
+    {
+        size_t last = Depths;
+        while ( last > 0 && depths[last - 1] == 0 )
+            last--;
+        out << "[";
+        for ( size_t d = 0; d < last; d++ )
+            out << ( d > 0 ? ", " : "" ) << depths[d];
+        out << "]";
+    }
+};
+
+/**
+ * The statistics policy of a MinimumHeap whose Stats argument is not given:
+ * MinimumHeapStats when MINIMUMHEAP_STATS is defined (e.g. in canary builds),
+ * otherwise MinimumHeapNoStats.
+ */
+#ifdef MINIMUMHEAP_STATS
+typedef MinimumHeapStats MinimumHeapDefaultStats;
+#else
+typedef MinimumHeapNoStats MinimumHeapDefaultStats;
+#endif
+
+/**
+ * Selects the comparison a MinimumHeap passes to the sift engine: its own
+ * Compare object (by reference) when statistics are disabled, or a wrapper
+ * counting every call when they are enabled. The wrapper hides the type of
+ * Compare, so child selection is never vectorised while counting.
+ */
+template <typename Compare, typename Stats, bool Enabled = Stats::enabled>
+struct MinimumHeapStatsLess {
+
+    typedef Compare& type;
+
+    static type make ( Compare& compare, Stats& ) { return compare; }
+};
+
+template <typename Compare, typename Stats>
+struct MinimumHeapStatsLess<Compare, Stats, true> {
+
+    struct type {
+        Compare& compare;
+        Stats& stats;
+
+        template <typename T>
+        bool operator() ( const T& lhs, const T& rhs )
+        {
+            stats.compared();
+            return compare ( lhs, rhs );
+        }
+    };
+
+    static type make ( Compare& compare, Stats& stats ) { return type { compare, stats }; }
+};
+
+/**
+ * The placement observer a MinimumHeap passes to the sift engine: it ignores
+ * every placement when statistics are disabled, or counts each one as a move
+ * when they are enabled. depth() produces the number of levels the sift moved
+ * its element by.
+ */
+template <typename Stats, bool Enabled = Stats::enabled>
+struct MinimumHeapStatsPlacement {
+
+    explicit MinimumHeapStatsPlacement ( Stats& ) { }
+    void operator() ( size_t ) const { }
+    size_t depth ( ) const { return 0; }
+};
+
+template <typename Stats>
+struct MinimumHeapStatsPlacement<Stats, true> {
+
+    Stats& stats;
+    size_t count = 0;
+
+    explicit MinimumHeapStatsPlacement ( Stats& stats ) : stats ( stats ) { }
+
+    void operator() ( size_t )
+    {
+        stats.moved();
+        count++;
+    }
+
+    size_t depth ( ) const { return count > 0 ? count - 1 : 0; }
+};
+
+#endif // MINIMUMHEAPSTATS_H
@@ -0,0 +1,230 @@
+#ifndef MINMAXHEAP_H
+#define MINMAXHEAP_H
+
+#include <functional>
+#include <optional>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * A double-ended heap of Comparable elements (a min-max heap), giving access
+ * to both the smallest and the largest element, for example the cheapest item
+ * to serve next and the most expensive one to evict when full, without keeping
+ * two heaps of the same elements.
+ *
+ * The elements are arranged in a vector as a binary MinimumHeap is, the
+ * children of index i at 2i + 1 and 2i + 2, but the levels alternate: an
+ * element on an even level (the root's) is the smallest of its subtree, one on
+ * an odd level the largest (Atkinson, Sack, Santoro and Strothotte, "Min-max
+ * heaps and generalized priority queues", CACM 1986). The smallest element is
+ * the root and the largest the larger of its two children, so both are found
+ * in O(1). An element is sifted up along the levels of its own kind, comparing
+ * with its grandparent, and down by moving the hole to the extreme of its
+ * grandchildren (or of its children without children of their own), so insert,
+ * pop_min and pop_max take O(log n). Building from a vector uses the same
+ * bottom up (Floyd) method as MinimumHeap, in O(n).
+ *
+ * A MinMaxHeap constructed with a bound holds at most that many elements:
+ * inserting into a full one evicts the largest element, which may be the one
+ * inserted, with a single sift from the largest element's slot (see
+ * push_evict).
+ *
+ * Elements are ordered by the Compare function object (default =
+ * std::less<Comparable>, i.e. the less than operator).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, typename Compare = std::less<Comparable>> class MinMaxHeap {
+
+private:
+
+    /** The elements of the MinMaxHeap arranged in a vector. **/
+    std::vector<Comparable> _elements;
+
+    /** The largest number of elements held, or 0 if unbounded. **/
+    size_t _bound;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Determines if the given index is on a max level (an odd level).
+     * @param index: the index of an element.
+     * @return true if the element at the index is the largest of its subtree.
+     */
+    static bool maxLevel ( size_t index );
+
+    /**
+     * Determines if a belongs above b on a level of the given kind: a is
+     * smaller than b on a min level, larger on a max level.
+     */
+    template <bool Max>
+    bool above ( const Comparable& a, const Comparable& b ) const;
+
+    /**
+     * Sifts the given value down from the hole at the given index, on levels
+     * of the given kind, and places it.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed.
+     */
+    template <bool Max>
+    void siftDown ( size_t hole, Comparable value );
+
+    /**
+     * Sifts the given value up from the hole at the given index, along the
+     * levels of the given kind (comparing with grandparents), and places it.
+     * @param hole: the index of the hole.
+     * @param value: the value to be placed.
+     */
+    template <bool Max>
+    void siftUp ( size_t hole, Comparable value );
+
+    /**
+     * Places the given value in the hole at the end of the heap.
+     * @param value: the value to be placed.
+     */
+    void siftUp ( Comparable value );
+
+    /**
+     * Produces the index of the largest element of a non-empty heap.
+     * @return 0, 1 or 2.
+     */
+    size_t maxIndex ( ) const;
+
+    /**
+     * Arranges the elements into a min-max heap, bottom up.
+     */
+    void makeMinMaxHeap ( );
+
+    /**
+     * Replaces the largest element of a non-empty heap by the given value,
+     * which must not be larger, and produces it.
+     * @param value: the value replacing the largest element.
+     * @return the replaced element.
+     */
+    Comparable replaceMax ( Comparable value );
+
+public:
+
+    /**
+     * Instantiate an empty MinMaxHeap given the initial capacity (default = 2)
+     * of the underlying vector and its bound.
+     * @param capacity: the initial capacity.
+     * @param bound: the largest number of elements held (default = 0, no
+     * bound). A bounded MinMaxHeap reserves its bound and never grows.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit MinMaxHeap ( size_t capacity = 2, size_t bound = 0, const Compare& compare = Compare() );
+
+    /**
+     * Instantiate an unbounded MinMaxHeap by copying elements from the given
+     * vector.
+     * @param vec: the vector to copy elements from.
+     * @param compare: the function object used to order the elements.
+    **/
+    MinMaxHeap ( const std::vector<Comparable>& vec, const Compare& compare = Compare() );
+
+    /**
+     * Instantiate an unbounded MinMaxHeap by moving elements from the given
+     * vector.
+     * @param vec: the vector to move elements from.
+     * @param compare: the function object used to order the elements.
+    **/
+    MinMaxHeap ( std::vector<Comparable>&& vec, const Compare& compare = Compare() );
+
+    /**
+     * Produces the current size of the MinMaxHeap.
+     * @return number of elements in the MinMaxHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Produces the largest number of elements the MinMaxHeap holds.
+     * @return the bound of the MinMaxHeap, or 0 if unbounded.
+     */
+    size_t bound() const;
+
+    /**
+     * Determines if the MinMaxHeap is empty (it contains no elements).
+     * @return true if the MinMaxHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Determines if the MinMaxHeap holds as many elements as its bound, i.e.
+     * a further insert evicts the largest element.
+     * @return true if the MinMaxHeap is bounded and full, false otherwise.
+     */
+    bool full() const;
+
+    /**
+     * Resets the MinMaxHeap to be empty. The capacity is unchanged.
+     */
+    void clear();
+
+    /**
+     * Produces the smallest element without removing it.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the MinMaxHeap is empty
+     */
+    const Comparable& top_min ( ) const;
+
+    /**
+     * Produces the largest element without removing it.
+     * @return the value of the largest element.
+     * @throws MinimumHeapUnderflowException if the MinMaxHeap is empty
+     */
+    const Comparable& top_max ( ) const;
+
+    /**
+     * Inserts the given element into the heap. If the MinMaxHeap is full, the
+     * largest element (possibly the given one) is evicted instead.
+     * @param element: the element to be inserted into the heap.
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it. If the MinMaxHeap
+     * is full, the largest element (possibly the given one) is evicted instead.
+     * @param element: the element to be inserted (moved) into the heap.
+     */
+    void insert ( Comparable&& element );
+
+    /**
+     * Inserts the given element into the heap and produces the element evicted
+     * to make room for it, if the MinMaxHeap is full: the largest element, or
+     * the given one itself if it is not smaller than the largest.
+     * @param element: the element to be inserted (moved) into the heap.
+     * @return the evicted element, or none if the MinMaxHeap was not full.
+     */
+    std::optional<Comparable> push_evict ( Comparable element );
+
+    /**
+     * Produces the smallest element and removes it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the MinMaxHeap is empty
+     */
+    Comparable pop_min ( );
+
+    /**
+     * Produces the largest element and removes it from the heap.
+     * @return the value of the largest element.
+     * @throws MinimumHeapUnderflowException if the MinMaxHeap is empty
+     */
+    Comparable pop_max ( );
+
+    /**
+     * Determines if the elements satisfy the min-max property: each element
+     * on a min level is not larger, and each on a max level not smaller, than
+     * every element of its subtree.
+     * @return true if the elements form a min-max heap, false otherwise.
+     */
+    bool is_min_max_heap ( ) const;
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "minmaxheap.tpp"
+
+#endif // MINMAXHEAP_H
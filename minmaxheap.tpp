@@ -0,0 +1,302 @@
+#include "minmaxheap.h"
+
+template <typename Comparable, typename Compare>
+bool MinMaxHeap<Comparable, Compare>::maxLevel ( size_t index )
+{
+    size_t level = 0;
+    for ( size_t n = index + 1; n > 1; n >>= 1 )
+        level++;
+    return level & 1;
+}
+
+template <typename Comparable, typename Compare>
+template <bool Max>
+bool MinMaxHeap<Comparable, Compare>::above ( const Comparable& a, const Comparable& b ) const
+{
+    return Max ? _compare ( b, a ) : _compare ( a, b );
+}
+
+template <typename Comparable, typename Compare>
+template <bool Max>
+void MinMaxHeap<Comparable, Compare>::siftDown ( size_t hole, Comparable value )
+{
+    size_t size = _elements.size();
+    while ( true )
+    {
+        // The candidates: the grandchildren, and the children without
+        // children (a child with children never belongs above all of them).
+        size_t grandchild = 4 * hole + 3;
+        size_t best;
+        if ( grandchild < size )
+        {
+            best = grandchild;
+            size_t end = std::min ( grandchild + 4, size );
+            for ( size_t i = grandchild + 1; i < end; i++ )
+                if ( above<Max> ( _elements[i], _elements[best] ) )
+                    best = i;
+            size_t child = 2 * hole + 2;
+            if ( child < size && 4 * hole + 5 >= size && above<Max> ( _elements[child], _elements[best] ) )
+                best = child;
+        }
+        else
+        {
+            size_t child = 2 * hole + 1;
+            if ( child >= size )
+                break;
+            best = child;
+            if ( child + 1 < size && above<Max> ( _elements[child + 1], _elements[best] ) )
+                best = child + 1;
+        }
+
+        if ( !above<Max> ( _elements[best], value ) )
+            break;
+        _elements[hole] = std::move ( _elements[best] );
+        hole = best;
+        if ( best < grandchild )
+            break;
+        // The value moved down past the parent of the hole, on a level of the
+        // other kind, which it may now belong above.
+        Comparable& parent = _elements[( hole - 1 ) / 2];
+        if ( above<!Max> ( value, parent ) )
+            std::swap ( value, parent );
+    }
+    _elements[hole] = std::move ( value );
+}
+
+template <typename Comparable, typename Compare>
+template <bool Max>
+void MinMaxHeap<Comparable, Compare>::siftUp ( size_t hole, Comparable value )
+{
+    while ( hole >= 3 )
+    {
+        size_t grandparent = ( hole - 3 ) / 4;
+        if ( !above<Max> ( value, _elements[grandparent] ) )
+            break;
+        _elements[hole] = std::move ( _elements[grandparent] );
+        hole = grandparent;
+    }
+    _elements[hole] = std::move ( value );
+}
+
+template <typename Comparable, typename Compare>
+void MinMaxHeap<Comparable, Compare>::siftUp ( Comparable value )
+{
+    size_t hole = _elements.size();
+    _elements.emplace_back ( std::move ( value ) );
+    if ( hole == 0 )
+        return;
+    Comparable moved = std::move ( _elements[hole] );
+    size_t parent = ( hole - 1 ) / 2;
+    if ( maxLevel ( hole ) )
+    {
+        if ( _compare ( moved, _elements[parent] ) )
+        {
+            _elements[hole] = std::move ( _elements[parent] );
+            siftUp<false> ( parent, std::move ( moved ) );
+        }
+        else
+            siftUp<true> ( hole, std::move ( moved ) );
+    }
+    else
+    {
+        if ( _compare ( _elements[parent], moved ) )
+        {
+            _elements[hole] = std::move ( _elements[parent] );
+            siftUp<true> ( parent, std::move ( moved ) );
+        }
+        else
+            siftUp<false> ( hole, std::move ( moved ) );
+    }
+}
+
+template <typename Comparable, typename Compare>
+size_t MinMaxHeap<Comparable, Compare>::maxIndex ( ) const
+{
+    if ( _elements.size() == 1 )
+        return 0;
+    if ( _elements.size() == 2 || !_compare ( _elements[1], _elements[2] ) )
+        return 1;
+    return 2;
+}
+
+template <typename Comparable, typename Compare>
+void MinMaxHeap<Comparable, Compare>::makeMinMaxHeap ( )
+{
+    size_t size = _elements.size();
+    if ( size < 2 )
+        return;
+    // Walks the parents from the last one up, a level at a time.
+    size_t last = ( size - 2 ) / 2;
+    size_t first = 0;
+    bool max = false;
+    while ( 2 * first + 1 <= last )
+    {
+        first = 2 * first + 1;
+        max = !max;
+    }
+    for ( size_t i = last + 1; i-- > 0; )
+    {
+        Comparable value = std::move ( _elements[i] );
+        if ( max )
+            siftDown<true> ( i, std::move ( value ) );
+        else
+            siftDown<false> ( i, std::move ( value ) );
+        if ( i == first && i > 0 )
+        {
+            first = ( first - 1 ) / 2;
+            max = !max;
+        }
+    }
+}
+
+template <typename Comparable, typename Compare>
+Comparable MinMaxHeap<Comparable, Compare>::replaceMax ( Comparable value )
+{
+    size_t max = maxIndex();
+    Comparable replaced = std::move ( _elements[max] );
+    if ( max == 0 )
+    {
+        _elements[0] = std::move ( value );
+        return replaced;
+    }
+    // The value is not larger than the replaced element, but may be smaller
+    // than the root, its parent.
+    if ( _compare ( value, _elements[0] ) )
+        std::swap ( value, _elements[0] );
+    siftDown<true> ( max, std::move ( value ) );
+    return replaced;
+}
+
+template <typename Comparable, typename Compare>
+MinMaxHeap<Comparable, Compare>::MinMaxHeap ( size_t capacity, size_t bound, const Compare& compare )
+    : _bound { bound }, _compare { compare }
+{
+    _elements.reserve ( bound > 0 ? bound : capacity );
+}
+
+template <typename Comparable, typename Compare>
+MinMaxHeap<Comparable, Compare>::MinMaxHeap ( const std::vector<Comparable>& vec, const Compare& compare )
+    : _elements ( vec ), _bound { 0 }, _compare { compare }
+{
+    makeMinMaxHeap();
+}
+
+template <typename Comparable, typename Compare>
+MinMaxHeap<Comparable, Compare>::MinMaxHeap ( std::vector<Comparable>&& vec, const Compare& compare )
+    : _elements ( std::move ( vec ) ), _bound { 0 }, _compare { compare }
+{
+    makeMinMaxHeap();
+}
+
+template <typename Comparable, typename Compare>
+size_t MinMaxHeap<Comparable, Compare>::size() const
+{
+    return _elements.size();
+}
+
+template <typename Comparable, typename Compare>
+size_t MinMaxHeap<Comparable, Compare>::bound() const
+{
+    return _bound;
+}
+
+template <typename Comparable, typename Compare>
+bool MinMaxHeap<Comparable, Compare>::empty() const
+{
+    return _elements.empty();
+}
+
+template <typename Comparable, typename Compare>
+bool MinMaxHeap<Comparable, Compare>::full() const
+{
+    return _bound > 0 && _elements.size() >= _bound;
+}
+
+template <typename Comparable, typename Compare>
+void MinMaxHeap<Comparable, Compare>::clear()
+{
+    _elements.clear();
+}
+
+template <typename Comparable, typename Compare>
+const Comparable& MinMaxHeap<Comparable, Compare>::top_min ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _elements[0];
+}
+
+template <typename Comparable, typename Compare>
+const Comparable& MinMaxHeap<Comparable, Compare>::top_max ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _elements[maxIndex()];
+}
+
+template <typename Comparable, typename Compare>
+void MinMaxHeap<Comparable, Compare>::insert ( const Comparable& element )
+{
+    push_evict ( element );
+}
+
+template <typename Comparable, typename Compare>
+void MinMaxHeap<Comparable, Compare>::insert ( Comparable&& element )
+{
+    push_evict ( std::move ( element ) );
+}
+
+template <typename Comparable, typename Compare>
+std::optional<Comparable> MinMaxHeap<Comparable, Compare>::push_evict ( Comparable element )
+{
+    if ( !full() )
+    {
+        siftUp ( std::move ( element ) );
+        return std::nullopt;
+    }
+    if ( !_compare ( element, top_max() ) )
+        return element;
+    return replaceMax ( std::move ( element ) );
+}
+
+template <typename Comparable, typename Compare>
+Comparable MinMaxHeap<Comparable, Compare>::pop_min ( )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _elements[0] );
+    Comparable last = std::move ( _elements.back() );
+    _elements.pop_back();
+    if ( !_elements.empty() )
+        siftDown<false> ( 0, std::move ( last ) );
+    return min;
+}
+
+template <typename Comparable, typename Compare>
+Comparable MinMaxHeap<Comparable, Compare>::pop_max ( )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    size_t index = maxIndex();
+    Comparable max = std::move ( _elements[index] );
+    Comparable last = std::move ( _elements.back() );
+    _elements.pop_back();
+    if ( index < _elements.size() )
+        siftDown<true> ( index, std::move ( last ) );
+    return max;
+}
+
+template <typename Comparable, typename Compare>
+bool MinMaxHeap<Comparable, Compare>::is_min_max_heap ( ) const
+{
+    for ( size_t i = 1; i < _elements.size(); i++ )
+    {
+        size_t parent = ( i - 1 ) / 2;
+        bool max = maxLevel ( i );
+        if ( max ? _compare ( _elements[i], _elements[parent] ) : _compare ( _elements[parent], _elements[i] ) )
+            return false;
+        if ( i >= 3 )
+        {
+            size_t grandparent = ( i - 3 ) / 4;
+            if ( max ? _compare ( _elements[grandparent], _elements[i] ) : _compare ( _elements[i], _elements[grandparent] ) )
+                return false;
+        }
+    }
+    return true;
+}
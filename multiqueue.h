@@ -0,0 +1,161 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "minimumheap.h"
+
+/**
+ * A relaxed concurrent priority queue (a MultiQueue) of Comparable elements,
+ * safe to use from any number of threads at once.
+ *
+ * The elements are spread over c * P shards, where P is the expected number of
+ * threads and c (default = 2) the number of shards per thread, each of which
+ * is an ordinary MinimumHeap guarded by its own spin lock. A lock is only ever
+ * tried, never waited on: a thread that fails to take a lock simply picks
+ * another shard, so threads rarely contend on the same cache lines. Each
+ * shard keeps its own size, so no counter is shared either; size() sums them.
+ *
+ * insert adds the element to a randomly chosen shard. pop locks two randomly
+ * chosen shards and removes the smaller of their two tops. pop is therefore
+ * relaxed: it does not always produce the smallest element in the queue, but
+ * the rank of the element it produces (the number of smaller elements in the
+ * queue) is O(c * P) in expectation, and the probability of a rank much larger
+ * than that falls off exponentially (Rihani, Sanders and Dementiev, "MultiQueues:
+ * Simple Relaxed Concurrent Priority Queues", SPAA 2015). Every element
+ * inserted is popped exactly once. With a single shard the queue is exact.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          typename Compare = std::less<Comparable>> class MultiQueue {
+
+private:
+
+    /** A MinimumHeap with its spin lock and its size, alone on its cache
+     * lines. The size is published on unlock, for readers not holding the
+     * lock. **/
+    struct alignas(64) Shard {
+        std::atomic<bool> locked { false };
+        std::atomic<size_t> size { 0 };
+        MinimumHeap<Comparable, Arity, MinimumHeapPop::TopDown, Compare> heap;
+
+        bool tryLock ( );
+        void unlock ( );
+    };
+
+    /** Tries the lock of a shard, holding it (if taken) until it goes out of
+     * scope, so that a throwing insert, pop or comparison unlocks it. **/
+    class ShardLock {
+        Shard* _shard;
+    public:
+        explicit ShardLock ( Shard& shard );
+        ~ShardLock ( );
+        ShardLock ( const ShardLock& rhs ) = delete;
+        ShardLock& operator= ( const ShardLock& rhs ) = delete;
+        /** Determines if the lock was taken. **/
+        explicit operator bool ( ) const { return _shard != nullptr; }
+    };
+
+    /** The shards of the MultiQueue. **/
+    std::unique_ptr<Shard[]> _shards;
+
+    /** The number of shards. **/
+    size_t _count;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Produces a random shard index for the calling thread.
+     * @return an index from 0 to the number of shards - 1.
+     */
+    size_t randomShard ( ) const;
+
+    /**
+     * Removes the smallest element of the first non-empty shard it can lock,
+     * by visiting every shard in turn, skipping those locked by other threads
+     * and sweeping again until it has seen every shard empty. Used when
+     * random choices keep finding empty shards.
+     * @param element: the variable that will contain the removed element.
+     * @return true if an element was removed, false if the queue was empty.
+     */
+    bool popAny ( Comparable& element );
+
+public:
+
+    /**
+     * Instantiate a MultiQueue for the given number of threads.
+     * @param threads: the expected number of threads (default = the number of
+     * hardware threads).
+     * @param shardsPerThread: the number of shards per thread (default = 2).
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit MultiQueue ( size_t threads = std::thread::hardware_concurrency(),
+                          size_t shardsPerThread = 2,
+                          const Compare& compare = Compare() );
+
+    MultiQueue ( const MultiQueue& rhs ) = delete;
+    MultiQueue& operator= ( const MultiQueue& rhs ) = delete;
+
+    /**
+     * Produces the number of shards the elements are spread over.
+     * @return the number of shards.
+     */
+    size_t shards() const;
+
+    /**
+     * Produces the approximate size of the MultiQueue, the sum of the sizes
+     * of its shards, which are kept per shard so that inserts and pops do not
+     * contend on a shared counter. While other threads are using the queue,
+     * the size may miss the operations in progress and may already have
+     * changed by the time it is returned.
+     * @return number of elements in the MultiQueue.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the MultiQueue is empty (it contains no elements).
+     * @return true if the MultiQueue is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Inserts the given element into a randomly chosen shard.
+     * @param element: the element to be inserted into the queue
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into a randomly chosen shard by moving it.
+     * @param element: the element to be inserted (moved) into the queue
+     */
+    void insert ( Comparable&& element );
+
+    /**
+     * Removes one of the smallest elements from the queue (the smaller top of
+     * two randomly chosen shards), moving it to the given parameter.
+     * @param element: the variable that will contain the removed element, if
+     * such an element exists.
+     * @return true if an element was removed, false if the queue was empty.
+     */
+    bool try_pop ( Comparable& element );
+
+    /**
+     * Removes one of the smallest elements from the queue (the smaller top of
+     * two randomly chosen shards).
+     * @return the removed element.
+     * @throws MinimumHeapUnderflowException if the MultiQueue is empty
+     */
+    Comparable pop ();
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "multiqueue.tpp"
+
+#endif // MULTIQUEUE_H
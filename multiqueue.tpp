@@ -0,0 +1,187 @@
+#include "multiqueue.h"
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool MultiQueue<Comparable, Arity, Compare>::Shard::tryLock ( )
+{
+    return !locked.load ( std::memory_order_relaxed )
+            && !locked.exchange ( true, std::memory_order_acquire );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void MultiQueue<Comparable, Arity, Compare>::Shard::unlock ( )
+{
+    size.store ( heap.size(), std::memory_order_relaxed );
+    locked.store ( false, std::memory_order_release );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+MultiQueue<Comparable, Arity, Compare>::ShardLock::ShardLock ( Shard& shard )
+    : _shard { shard.tryLock() ? &shard : nullptr }
+{
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+MultiQueue<Comparable, Arity, Compare>::ShardLock::~ShardLock ( )
+{
+    if ( _shard != nullptr )
+        _shard->unlock();
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t MultiQueue<Comparable, Arity, Compare>::randomShard ( ) const
+{
+    // xorshift64*, seeded differently for every thread.
+    thread_local uint64_t state = 0x9E3779B97F4A7C15ull
+            ^ std::hash<std::thread::id>() ( std::this_thread::get_id() );
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<size_t> ( ( state * 0x2545F4914F6CDD1Dull ) >> 32 ) % _count;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool MultiQueue<Comparable, Arity, Compare>::popAny ( Comparable& element )
+{
+    for ( ;; )
+    {
+        bool busy = false;
+        size_t start = randomShard();
+        for ( size_t i = 0; i < _count; i++ )
+        {
+            Shard& shard = _shards[( start + i ) % _count];
+            if ( shard.size.load ( std::memory_order_relaxed ) == 0 )
+                continue;
+            ShardLock lock ( shard );
+            if ( !lock )
+                busy = true;
+            else if ( !shard.heap.empty() )
+            {
+                shard.heap.pop ( element );
+                return true;
+            }
+        }
+        if ( !busy )
+            return false;
+        // The elements left are in shards locked by other threads.
+        std::this_thread::yield();
+    }
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+MultiQueue<Comparable, Arity, Compare>::MultiQueue ( size_t threads, size_t shardsPerThread,
+                                                     const Compare& compare )
+    : _count { std::max<size_t> ( 1, std::max<size_t> ( 1, threads ) * shardsPerThread ) },
+      _compare { compare }
+{
+    _shards.reset ( new Shard[_count] );
+    for ( size_t i = 0; i < _count; i++ )
+        _shards[i].heap = MinimumHeap<Comparable, Arity, MinimumHeapPop::TopDown, Compare> ( 2, compare );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t MultiQueue<Comparable, Arity, Compare>::shards() const
+{
+    return _count;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t MultiQueue<Comparable, Arity, Compare>::size() const
+{
+    size_t size = 0;
+    for ( size_t i = 0; i < _count; i++ )
+        size += _shards[i].size.load ( std::memory_order_relaxed );
+    return size;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool MultiQueue<Comparable, Arity, Compare>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void MultiQueue<Comparable, Arity, Compare>::insert ( const Comparable& element )
+{
+    Comparable copy = element;
+    insert ( std::move ( copy ) );
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void MultiQueue<Comparable, Arity, Compare>::insert ( Comparable&& element )
+{
+    for ( ;; )
+    {
+        Shard& shard = _shards[randomShard()];
+        ShardLock lock ( shard );
+        if ( lock )
+        {
+            shard.heap.insert ( std::move ( element ) );
+            return;
+        }
+    }
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool MultiQueue<Comparable, Arity, Compare>::try_pop ( Comparable& element )
+{
+    size_t misses = 0;
+    for ( ;; )
+    {
+        // Keep finding empty shards: the few remaining elements are easier
+        // found by visiting every shard.
+        if ( misses > _count )
+            return popAny ( element );
+
+        size_t a = randomShard();
+        size_t b = randomShard();
+        if ( a == b && _count > 1 )
+            continue;
+        Shard& first = _shards[a];
+        Shard& second = _shards[b];
+        if ( first.size.load ( std::memory_order_relaxed ) == 0
+             && second.size.load ( std::memory_order_relaxed ) == 0 )
+        {
+            misses++;
+            continue;
+        }
+        ShardLock firstLock ( first );
+        if ( !firstLock )
+            continue;
+        if ( a == b )
+        {
+            if ( first.heap.empty() )
+            {
+                misses++;
+                continue;
+            }
+            first.heap.pop ( element );
+            return true;
+        }
+        ShardLock secondLock ( second );
+        if ( !secondLock )
+            continue;
+
+        Shard* chosen = nullptr;
+        if ( first.heap.empty() )
+            chosen = second.heap.empty() ? nullptr : &second;
+        else if ( second.heap.empty() || !_compare ( second.heap.top(), first.heap.top() ) )
+            chosen = &first;
+        else
+            chosen = &second;
+
+        if ( chosen != nullptr )
+        {
+            chosen->heap.pop ( element );
+            return true;
+        }
+        misses++;
+    }
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+Comparable MultiQueue<Comparable, Arity, Compare>::pop ()
+{
+    Comparable element;
+    if ( !try_pop ( element ) ) { throw MinimumHeapUnderflowException(); }
+    return element;
+}
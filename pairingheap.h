@@ -0,0 +1,193 @@
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+
+#include <functional>
+#include <ostream>
+#include <iostream>
+#include <utility>
+#include "minimumheap.h"
+
+/**
+ * A meldable minimum heap of Comparable elements (a pairing heap), for
+ * workloads which merge whole heaps often, such as rebalancing shards or
+ * stealing work between schedulers.
+ *
+ * Each element is held in its own node of a heap-ordered tree whose children
+ * are kept in a singly linked list. merge links the root of one tree below the
+ * root of the other in O(1), regardless of the sizes of the heaps; insert is a
+ * merge with a single node. pop removes the root and links its children in two
+ * passes (pairs from left to right, then the pairs from right to left), which
+ * takes O(log n) amortised time (Fredman, Sedgewick, Sleator and Tarjan, "The
+ * pairing heap: A new form of self-adjusting heap", Algorithmica 1986).
+ *
+ * It offers the same insert, emplace, top, pop, merge, size and empty
+ * operations as MinimumHeap. Between merges, which of the two is faster
+ * depends on the workload and its size (see benchmarks/meld_benchmark.cpp): a
+ * pairing heap allocates a node per element and follows a pointer per
+ * comparison, which costs the most once the heap outgrows the caches, while a
+ * MinimumHeap keeps its elements contiguous.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, typename Compare = std::less<Comparable>> class PairingHeap {
+
+private:
+
+    /** A node of the tree: an element, its first child and its next sibling. **/
+    struct Node {
+        Comparable value;
+        Node* child;
+        Node* sibling;
+
+        template <typename... Args>
+        explicit Node ( Args&&... args )
+            : value ( std::forward<Args> ( args )... ), child { nullptr }, sibling { nullptr } {}
+    };
+
+    /** The root of the tree (the smallest element), or null if empty. **/
+    Node* _root;
+
+    /** The current size of the PairingHeap. **/
+    size_t _size;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /**
+     * Links two trees, making the root with the larger element the first
+     * child of the other.
+     * @param a: the root of a tree (not null).
+     * @param b: the root of another tree (not null).
+     * @return the root of the linked tree.
+     */
+    Node* link ( Node* a, Node* b );
+
+    /**
+     * Links the given list of sibling trees into one tree in two passes.
+     * @param first: the first tree of the list, or null.
+     * @return the root of the linked tree, or null if the list is empty.
+     */
+    Node* combine ( Node* first );
+
+    /**
+     * Deletes every node of the tree with the given root, without recursion.
+     * @param root: the root of the tree, or null.
+     */
+    static void destroy ( Node* root );
+
+    /**
+     * Links the given node below the root of the heap.
+     * @param node: the node to be added.
+     */
+    void add ( Node* node );
+
+public:
+
+    /**
+     * Instantiate an empty PairingHeap.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit PairingHeap ( const Compare& compare = Compare() );
+
+    PairingHeap ( const PairingHeap& rhs ) = delete;
+    PairingHeap& operator= ( const PairingHeap& rhs ) = delete;
+
+    /**
+     * Instantiate a PairingHeap by taking the nodes of an existing temporary
+     * PairingHeap, which is left empty.
+     * (Move Constructor)
+     * @param rhs: the PairingHeap to move nodes from.
+    **/
+    PairingHeap ( PairingHeap&& rhs );
+
+    /**
+     * Takes the nodes of an assigned temporary PairingHeap, which is left
+     * empty, deleting the nodes held before.
+     * (Move Assignment Constructor)
+     * @param rhs: the PairingHeap to move nodes from.
+    **/
+    PairingHeap& operator= ( PairingHeap&& rhs );
+
+    /**
+     * Destructor
+    **/
+    ~PairingHeap ( );
+
+    /**
+     * Produces the current size of the PairingHeap.
+     * @return number of elements in the PairingHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the PairingHeap is empty (it contains no elements).
+     * @return true if the PairingHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Resets the PairingHeap to be empty, deleting every node.
+     */
+    void clear();
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the PairingHeap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Inserts the given element into the heap in O(1).
+     * @param element: the element to be inserted into the heap
+     */
+    void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap in O(1) by moving it.
+     * @param element: the element to be inserted (moved) into the heap
+     */
+    void insert ( Comparable&& element );
+
+    /**
+     * Constructs an element from the given arguments in a new node and
+     * inserts it into the heap in O(1).
+     * @param args: the arguments passed to the constructor of Comparable.
+     */
+    template <typename... Args>
+    void emplace ( Args&&... args );
+
+    /**
+     * Moves every element of the given PairingHeap into this one in O(1),
+     * leaving the given heap empty. The order of the elements is that of
+     * this heap.
+     * @param other: the PairingHeap to be merged (moved) into this one.
+     */
+    void merge ( PairingHeap&& other );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the PairingHeap is empty
+     */
+    Comparable pop ();
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) implicitly moving it to the given parameter and removes it
+     * from the heap.
+     * @param element: the variable that will contain the smallest element
+     * from the heap, if such an element exists.
+     * @throws MinimumHeapUnderflowException if the PairingHeap is empty
+     */
+    void pop ( Comparable& element );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "pairingheap.tpp"
+
+#endif // PAIRINGHEAP_H
@@ -0,0 +1,194 @@
+#include "pairingheap.h"
+
+template <typename Comparable, typename Compare>
+typename PairingHeap<Comparable, Compare>::Node* PairingHeap<Comparable, Compare>::link ( Node* a, Node* b )
+{
+    if ( _compare ( b->value, a->value ) )
+        std::swap ( a, b );
+    b->sibling = a->child;
+    a->child = b;
+    return a;
+}
+
+template <typename Comparable, typename Compare>
+typename PairingHeap<Comparable, Compare>::Node* PairingHeap<Comparable, Compare>::combine ( Node* first )
+{
+    // First pass: link the trees in pairs from left to right, stacking the
+    // linked pairs so that the last pair ends up first.
+    Node* pairs = nullptr;
+    while ( first != nullptr )
+    {
+        Node* a = first;
+        Node* b = a->sibling;
+        if ( b == nullptr )
+        {
+            a->sibling = pairs;
+            pairs = a;
+            break;
+        }
+        first = b->sibling;
+        a->sibling = nullptr;
+        b->sibling = nullptr;
+        Node* pair = link ( a, b );
+        pair->sibling = pairs;
+        pairs = pair;
+    }
+
+    // Second pass: link the pairs from right to left into one tree.
+    if ( pairs == nullptr )
+        return nullptr;
+    Node* root = pairs;
+    pairs = pairs->sibling;
+    root->sibling = nullptr;
+    while ( pairs != nullptr )
+    {
+        Node* next = pairs->sibling;
+        pairs->sibling = nullptr;
+        root = link ( root, pairs );
+        pairs = next;
+    }
+    return root;
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::destroy ( Node* root )
+{
+    // Rotates each first child up into the sibling list until a node has no
+    // child, then deletes it and continues with its sibling.
+    while ( root != nullptr )
+    {
+        if ( root->child != nullptr )
+        {
+            Node* child = root->child;
+            root->child = child->sibling;
+            child->sibling = root;
+            root = child;
+        }
+        else
+        {
+            Node* next = root->sibling;
+            delete root;
+            root = next;
+        }
+    }
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::add ( Node* node )
+{
+    _root = _root == nullptr ? node : link ( _root, node );
+    _size++;
+}
+
+template <typename Comparable, typename Compare>
+PairingHeap<Comparable, Compare>::PairingHeap ( const Compare& compare )
+    : _root { nullptr }, _size { 0 }, _compare { compare } {}
+
+template <typename Comparable, typename Compare>
+PairingHeap<Comparable, Compare>::PairingHeap ( PairingHeap&& rhs )
+    : _root { rhs._root }, _size { rhs._size }, _compare { rhs._compare }
+{
+    rhs._root = nullptr;
+    rhs._size = 0;
+}
+
+template <typename Comparable, typename Compare>
+PairingHeap<Comparable, Compare>& PairingHeap<Comparable, Compare>::operator= ( PairingHeap&& rhs )
+{
+    if ( &rhs != this )
+    {
+        destroy ( _root );
+        _root = rhs._root;
+        _size = rhs._size;
+        _compare = rhs._compare;
+        rhs._root = nullptr;
+        rhs._size = 0;
+    }
+    return *this;
+}
+
+template <typename Comparable, typename Compare>
+PairingHeap<Comparable, Compare>::~PairingHeap ( )
+{
+    destroy ( _root );
+}
+
+template <typename Comparable, typename Compare>
+size_t PairingHeap<Comparable, Compare>::size() const
+{
+    return _size;
+}
+
+template <typename Comparable, typename Compare>
+bool PairingHeap<Comparable, Compare>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::clear()
+{
+    destroy ( _root );
+    _root = nullptr;
+    _size = 0;
+}
+
+template <typename Comparable, typename Compare>
+const Comparable& PairingHeap<Comparable, Compare>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _root->value;
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::insert ( const Comparable& element )
+{
+    add ( new Node ( element ) );
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::insert ( Comparable&& element )
+{
+    add ( new Node ( std::move ( element ) ) );
+}
+
+template <typename Comparable, typename Compare>
+template <typename... Args>
+void PairingHeap<Comparable, Compare>::emplace ( Args&&... args )
+{
+    add ( new Node ( std::forward<Args> ( args )... ) );
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::merge ( PairingHeap&& other )
+{
+    if ( &other == this || other._root == nullptr )
+        return;
+    _root = _root == nullptr ? other._root : link ( _root, other._root );
+    _size += other._size;
+    other._root = nullptr;
+    other._size = 0;
+}
+
+template <typename Comparable, typename Compare>
+Comparable PairingHeap<Comparable, Compare>::pop ()
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Node* root = _root;
+    Comparable min = std::move ( root->value );
+    _root = combine ( root->child );
+    _size--;
+    delete root;
+    return min;
+}
+
+template <typename Comparable, typename Compare>
+void PairingHeap<Comparable, Compare>::pop ( Comparable& element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Node* root = _root;
+    element = std::move ( root->value );
+    _root = combine ( root->child );
+    _size--;
+    delete root;
+}
@@ -0,0 +1,137 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <ostream>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * A monotone priority queue of unsigned integer keys (a radix heap), for
+ * workloads which never insert a key smaller than the last key popped, such as
+ * event simulations (timestamps) and Dijkstra's algorithm (distances).
+ *
+ * The keys are kept in one bucket per bit of the key plus one: a key goes into
+ * the bucket numbered by the highest bit in which it differs from the last key
+ * popped (bucket 0 holds keys equal to it). When bucket 0 runs out, the lowest
+ * non-empty bucket is emptied: its smallest key becomes the new last key and
+ * its other keys move to strictly lower buckets. As each key can only move
+ * down, insert is O(1) and pop is amortised O(log C), where C is the largest
+ * difference between keys in the queue, independent of the number of keys.
+ *
+ * It offers the same insert, top, pop, size and empty operations as
+ * MinimumHeap so one can replace the other by changing a template argument.
+ * Inserting a key smaller than the last key popped breaks the queue; debug
+ * builds (without NDEBUG) catch this with an assertion. top() only looks for
+ * the smallest key and leaves the buckets alone, so keys smaller than the top
+ * (but not the last key popped) may still be inserted after it.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Key> class RadixHeap {
+
+    static_assert ( std::is_integral<Key>::value && std::is_unsigned<Key>::value,
+                    "RadixHeap requires an unsigned integer key." );
+
+private:
+
+    /** The number of buckets: one per bit of the key plus one. **/
+    static constexpr size_t Buckets = std::numeric_limits<Key>::digits + 1;
+
+    /** The keys of the heap, bucketed by their difference from _last. **/
+    std::array<std::vector<Key>, Buckets> _buckets;
+
+    /** The last key popped. **/
+    Key _last;
+
+    /** The current size of the RadixHeap. **/
+    size_t _size;
+
+    /** The smallest key outside bucket 0, once it has been found. **/
+    mutable Key _top;
+
+    /** Whether _top holds the smallest key. **/
+    mutable bool _topFound;
+
+    /**
+     * Produces the bucket for the given key: 0 if it equals the last key
+     * popped, otherwise the position of the highest bit in which they differ.
+     * @param key: the key to be placed.
+     * @return the index of the bucket.
+     */
+    size_t bucket ( Key key ) const;
+
+    /**
+     * Ensures bucket 0 holds the smallest key, redistributing the lowest
+     * non-empty bucket if it is empty. The heap must not be empty.
+     */
+    void pull ( );
+
+public:
+
+    /**
+     * Instantiate an empty RadixHeap whose keys must be no smaller than the
+     * given key (default = 0).
+     * @param minimum: the smallest key that may be inserted.
+    **/
+    explicit RadixHeap ( Key minimum = 0 );
+
+    /**
+     * Produces the current size of the RadixHeap.
+     * @return number of keys in the RadixHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the RadixHeap is empty (it contains no keys).
+     * @return true if the RadixHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Resets the RadixHeap to be empty. The last key popped is unchanged, so
+     * subsequent keys must still be no smaller than it.
+     */
+    void clear();
+
+    /**
+     * Produces the smallest key in the heap without removing it.
+     * @return the smallest key.
+     * @throws MinimumHeapUnderflowException if the RadixHeap is empty
+     */
+    const Key& top ( ) const;
+
+    /**
+     * Inserts the given key into the heap. The key must be no smaller than the
+     * last key popped.
+     * @param key: the key to be inserted into the heap
+     */
+    void insert ( Key key );
+
+    /**
+     * Produces the smallest key in the heap and removes it.
+     * @return the smallest key.
+     * @throws MinimumHeapUnderflowException if the RadixHeap is empty
+     */
+    Key pop ();
+
+    /**
+     * Produces the smallest key in the heap, assigning it to the given
+     * parameter, and removes it.
+     * @param key: the variable that will contain the smallest key.
+     * @throws MinimumHeapUnderflowException if the RadixHeap is empty
+     */
+    void pop ( Key& key );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "radixheap.tpp"
+
+#endif // RADIXHEAP_H
@@ -0,0 +1,106 @@
+#include "radixheap.h"
+
+template <typename Key>
+size_t RadixHeap<Key>::bucket ( Key key ) const
+{
+    Key difference = key ^ _last;
+    size_t bits = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    if ( difference != 0 )
+        bits = std::numeric_limits<unsigned long long>::digits
+                - __builtin_clzll ( static_cast<unsigned long long> ( difference ) );
+#else
+    for ( ; difference != 0; difference >>= 1 )
+        bits++;
+#endif
+    return bits;
+}
+
+template <typename Key>
+void RadixHeap<Key>::pull ( )
+{
+    if ( !_buckets[0].empty() )
+        return;
+
+    size_t i = 1;
+    while ( _buckets[i].empty() )
+        i++;
+
+    std::vector<Key>& source = _buckets[i];
+    _last = _topFound ? _top : *std::min_element ( source.begin(), source.end() );
+    for ( size_t j = 0; j < source.size(); j++ )
+        _buckets[bucket ( source[j] )].push_back ( source[j] );
+    source.clear();
+    _topFound = false;
+}
+
+template <typename Key>
+RadixHeap<Key>::RadixHeap ( Key minimum )
+    : _last { minimum }, _size { 0 }, _top { minimum }, _topFound { false } {}
+
+template <typename Key>
+size_t RadixHeap<Key>::size() const
+{
+    return _size;
+}
+
+template <typename Key>
+bool RadixHeap<Key>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Key>
+void RadixHeap<Key>::clear()
+{
+    for ( size_t i = 0; i < Buckets; i++ )
+        _buckets[i].clear();
+    _size = 0;
+    _topFound = false;
+}
+
+template <typename Key>
+const Key& RadixHeap<Key>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    if ( !_buckets[0].empty() )
+        return _buckets[0].back();
+    if ( !_topFound )
+    {
+        size_t i = 1;
+        while ( _buckets[i].empty() )
+            i++;
+        _top = *std::min_element ( _buckets[i].begin(), _buckets[i].end() );
+        _topFound = true;
+    }
+    return _top;
+}
+
+template <typename Key>
+void RadixHeap<Key>::insert ( Key key )
+{
+    assert ( !( key < _last ) && "RadixHeap keys must not be smaller than the last key popped" );
+    size_t b = bucket ( key );
+    _buckets[b].push_back ( key );
+    _size++;
+    if ( _topFound && b != 0 && key < _top )
+        _top = key;
+}
+
+template <typename Key>
+Key RadixHeap<Key>::pop ()
+{
+    Key key;
+    pop ( key );
+    return key;
+}
+
+template <typename Key>
+void RadixHeap<Key>::pop ( Key& key )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    pull();
+    key = _buckets[0].back();
+    _buckets[0].pop_back();
+    _size--;
+}
@@ -0,0 +1,209 @@
+#ifndef STATICMINIMUMHEAP_H
+#define STATICMINIMUMHEAP_H
+
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include "minimumheap.h"
+
+/**
+ * A minimum heap of at most Capacity Comparable elements stored inline, in a
+ * std::array member, for the many tiny heaps of a server (e.g. a retry queue
+ * per connection with 8 to 64 entries): it never allocates, and a heap of a
+ * few small elements stays within one or two cache lines of its owner.
+ *
+ * It offers the same insert, top, pop and size operations as MinimumHeap,
+ * and uses the same sift engine (see MinimumHeapSift), but its capacity is
+ * fixed. Inserting into a full heap is reported explicitly: insert throws
+ * MinimumHeapOverflowException and try_insert returns false, leaving the heap
+ * unchanged.
+ *
+ * Every operation is constexpr, so that a heap of literal elements (e.g. a
+ * lookup table) can be heapified during compilation:
+ *
+ *     constexpr StaticMinimumHeap<int, 8> table { 5, 3, 8, 1 };
+ *     static_assert ( table.top() == 1 );
+ *
+ * Overflowing a heap during constant evaluation is a compile error.
+ *
+ * Comparable must be default constructible (the array holds Capacity
+ * elements at all times, the slots past size() default constructed or moved
+ * from). Elements are ordered by the Compare function object (default =
+ * std::less<Comparable>).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Capacity, size_t Arity = 2,
+          typename Compare = std::less<Comparable>> class StaticMinimumHeap {
+
+    static_assert ( Capacity > 0, "StaticMinimumHeap requires a Capacity of at least 1." );
+
+private:
+
+    /** The elements of the StaticMinimumHeap, the first _size of which are
+     * in the heap. **/
+    std::array<Comparable, Capacity> _elements;
+
+    /** The current size of the StaticMinimumHeap. **/
+    size_t _size;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+    /** The sift engine for the Arity of the StaticMinimumHeap. **/
+    typedef MinimumHeapSift<Arity> Sift;
+
+    /**
+     * Sifts the given element up from a new slot at the end of the heap,
+     * which must not be full.
+     * @param element: the element to be inserted (moved) into the heap.
+     */
+    constexpr void append ( Comparable&& element );
+
+    /**
+     * Refills the hole left at the root by removing the top element with the
+     * last element of the heap.
+     */
+    constexpr void fillRoot ( );
+
+public:
+
+    /**
+     * Instantiate an empty StaticMinimumHeap.
+     * @param compare: the function object used to order the elements.
+    **/
+    constexpr explicit StaticMinimumHeap ( const Compare& compare = Compare() );
+
+    /**
+     * Instantiate a StaticMinimumHeap from the given elements, building the
+     * heap bottom up (Floyd's method).
+     * @param elements: the elements of the heap.
+     * @param compare: the function object used to order the elements.
+     * @throws MinimumHeapOverflowException if there are more than Capacity
+     * elements
+    **/
+    constexpr StaticMinimumHeap ( std::initializer_list<Comparable> elements, const Compare& compare = Compare() );
+
+    /**
+     * Instantiate a StaticMinimumHeap from the elements of the range
+     * [first, last), building the heap bottom up (Floyd's method).
+     * @param first: the first element of the range.
+     * @param last: one past the last element of the range.
+     * @param compare: the function object used to order the elements.
+     * @throws MinimumHeapOverflowException if there are more than Capacity
+     * elements
+    **/
+    template <typename InputIterator>
+    constexpr StaticMinimumHeap ( InputIterator first, InputIterator last, const Compare& compare = Compare() );
+
+    /**
+     * Produces the current size of the StaticMinimumHeap.
+     * @return number of elements in the StaticMinimumHeap.
+     */
+    constexpr size_t size() const;
+
+    /**
+     * Produces the number of elements the StaticMinimumHeap can hold.
+     * @return Capacity.
+     */
+    static constexpr size_t capacity();
+
+    /**
+     * Determines if the StaticMinimumHeap is empty (it contains no elements).
+     * @return true if the StaticMinimumHeap is empty, false otherwise.
+     */
+    constexpr bool empty() const;
+
+    /**
+     * Determines if the StaticMinimumHeap is full (it holds Capacity elements).
+     * @return true if the StaticMinimumHeap is full, false otherwise.
+     */
+    constexpr bool full() const;
+
+    /**
+     * Resets the StaticMinimumHeap to be empty. The elements left in the
+     * array are not destroyed until it is.
+     */
+    constexpr void clear();
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) without removing it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the StaticMinimumHeap is empty
+     */
+    constexpr const Comparable& top ( ) const;
+
+    /**
+     * Produces the element at the given index of the heap, where index 0 is
+     * the top and indices Arity * i + 1 through Arity * i + Arity are the
+     * children of index i.
+     * @param index: the index of the element to return.
+     * @return the value of the element at the given index.
+     * @throws MinimumHeapIndexOutOfBoundsException if the index is not within
+     * the bounds [0, size).
+     */
+    constexpr const Comparable& operator[] ( size_t index ) const;
+
+    /**
+     * Inserts the given element into the heap.
+     * @param element: the element to be inserted into the heap
+     * @throws MinimumHeapOverflowException if the StaticMinimumHeap is full
+     */
+    constexpr void insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it.
+     * @param element: the element to be inserted (moved) into the heap
+     * @throws MinimumHeapOverflowException if the StaticMinimumHeap is full
+     */
+    constexpr void insert ( Comparable&& element );
+
+    /**
+     * Inserts the given element into the heap unless the heap is full.
+     * @param element: the element to be inserted into the heap
+     * @return true if the element was inserted, false if the heap is full.
+     */
+    constexpr bool try_insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it, unless the heap
+     * is full (the element is then left unchanged).
+     * @param element: the element to be inserted (moved) into the heap
+     * @return true if the element was inserted, false if the heap is full.
+     */
+    constexpr bool try_insert ( Comparable&& element );
+
+    /**
+     * Produces the element at the top of the heap (the smallest element in
+     * the heap) and removes it from the heap.
+     * @return the value of the smallest element.
+     * @throws MinimumHeapUnderflowException if the StaticMinimumHeap is empty
+     */
+    constexpr Comparable pop ( );
+
+    /**
+     * Moves the element at the top of the heap (the smallest element in the
+     * heap) into the given element and removes it from the heap.
+     * @param element: the element receiving the smallest element.
+     * @throws MinimumHeapUnderflowException if the StaticMinimumHeap is empty
+     */
+    constexpr void pop ( Comparable& element );
+
+    /**
+     * Replaces the element at the top of the heap with the given element,
+     * sifting it down once, and produces the element replaced. Works on a
+     * full heap.
+     * @param element: the element to be inserted (moved) into the heap.
+     * @return the value of the smallest element before the replacement.
+     * @throws MinimumHeapUnderflowException if the StaticMinimumHeap is empty
+     */
+    constexpr Comparable replace_top ( Comparable element );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "staticminimumheap.tpp"
+
+#endif // STATICMINIMUMHEAP_H
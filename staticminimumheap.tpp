@@ -0,0 +1,145 @@
+#include "staticminimumheap.h"
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::append ( Comparable&& element )
+{
+    MinimumHeapIgnorePlacement placed;
+    Sift::siftUp ( _elements.data(), 0, _size++, std::move ( element ), _compare, placed );
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::fillRoot ( )
+{
+    if ( --_size == 0 )
+        return;
+    MinimumHeapIgnorePlacement placed;
+    Comparable last = std::move ( _elements[_size] );
+    Sift::siftDown ( _elements.data(), _size, 0, std::move ( last ), _compare, placed );
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::StaticMinimumHeap ( const Compare& compare )
+    : _elements {}, _size { 0 }, _compare { compare } {}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::StaticMinimumHeap (
+        std::initializer_list<Comparable> elements, const Compare& compare )
+    : StaticMinimumHeap ( elements.begin(), elements.end(), compare ) {}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+template <typename InputIterator>
+constexpr StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::StaticMinimumHeap (
+        InputIterator first, InputIterator last, const Compare& compare )
+    : StaticMinimumHeap ( compare )
+{
+    for ( ; first != last; ++first )
+    {
+        if ( _size == Capacity ) { throw MinimumHeapOverflowException(); }
+        _elements[_size++] = *first;
+    }
+    MinimumHeapIgnorePlacement placed;
+    Sift::makeHeap ( _elements.data(), _size, _compare, placed );
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr size_t StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::size() const
+{
+    return _size;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr size_t StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::capacity()
+{
+    return Capacity;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr bool StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::empty() const
+{
+    return _size == 0;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr bool StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::full() const
+{
+    return _size == Capacity;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::clear()
+{
+    _size = 0;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr const Comparable& StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::top ( ) const
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    return _elements[0];
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr const Comparable& StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::operator[] ( size_t index ) const
+{
+    if ( index >= _size ) { throw MinimumHeapIndexOutOfBoundsException(); }
+    return _elements[index];
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::insert ( const Comparable& element )
+{
+    if ( full() ) { throw MinimumHeapOverflowException(); }
+    append ( Comparable ( element ) );
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::insert ( Comparable&& element )
+{
+    if ( full() ) { throw MinimumHeapOverflowException(); }
+    append ( std::move ( element ) );
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr bool StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::try_insert ( const Comparable& element )
+{
+    if ( full() )
+        return false;
+    append ( Comparable ( element ) );
+    return true;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr bool StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::try_insert ( Comparable&& element )
+{
+    if ( full() )
+        return false;
+    append ( std::move ( element ) );
+    return true;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr Comparable StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::pop ( )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _elements[0] );
+    fillRoot();
+    return min;
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr void StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::pop ( Comparable& element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    element = std::move ( _elements[0] );
+    fillRoot();
+}
+
+template <typename Comparable, size_t Capacity, size_t Arity, typename Compare>
+constexpr Comparable StaticMinimumHeap<Comparable, Capacity, Arity, Compare>::replace_top ( Comparable element )
+{
+    if ( empty() ) { throw MinimumHeapUnderflowException(); }
+    Comparable min = std::move ( _elements[0] );
+    MinimumHeapIgnorePlacement placed;
+    Sift::siftDown ( _elements.data(), _size, 0, std::move ( element ), _compare, placed );
+    return min;
+}
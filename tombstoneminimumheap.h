@@ -0,0 +1,208 @@
+#ifndef TOMBSTONEMINIMUMHEAP_H
+#define TOMBSTONEMINIMUMHEAP_H
+
+#include <functional>
+#include <vector>
+#include "minimumheap.h"
+
+/**
+ * A minimum heap of Comparable elements which can be cancelled in O(1) after
+ * insertion, for queues of work of which large fractions are regularly
+ * cancelled (e.g. every job of a disconnected tenant).
+ *
+ * Each insert produces a Handle. mark_deleted() turns the element of a
+ * handle into a tombstone by setting a flag, without touching the heap: the
+ * dead element is dropped when it reaches the top (top() and pop() only ever
+ * see live elements), or by a compaction. Once the tombstones make up more
+ * than the given fraction of the heap (default = 1/2), the heap is compacted
+ * (see MinimumHeap::erase_if), so it stays proportional to the live elements.
+ * Since a compaction of n elements follows at least threshold * n
+ * cancellations, its O(n) cost amortizes to O(1) per cancellation.
+ *
+ * The elements are held in a MinimumHeap, each with the slot of its flag;
+ * slots are reused once their element has left the heap, and a handle whose
+ * slot has since been reused is detected by its generation (as with
+ * AddressableMinimumHeap, which removes elements eagerly in O(log n)).
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          MinimumHeapPop Pop = MinimumHeapPop::TopDown,
+          typename Compare = std::less<Comparable>> class TombstoneMinimumHeap {
+
+public:
+
+    /**
+     * Refers to an element of the TombstoneMinimumHeap until it is popped,
+     * cancelled or the heap is cleared.
+     */
+    class Handle {
+        friend class TombstoneMinimumHeap;
+        size_t _slot = 0;
+        size_t _generation = 0;
+        Handle ( size_t slot, size_t generation )
+            : _slot{ slot }, _generation{ generation } {}
+    public:
+        Handle() = default;
+        bool operator== ( const Handle& rhs ) const
+            { return _slot == rhs._slot && _generation == rhs._generation; }
+        bool operator!= ( const Handle& rhs ) const { return !( *this == rhs ); }
+    };
+
+private:
+
+    /** An element of the heap with the slot holding its flag. **/
+    struct Entry {
+        Comparable value;
+        size_t slot;
+    };
+
+    /** The state of an element and the generation of the slot. **/
+    struct Slot {
+        size_t generation;
+        bool live;
+        bool dead;
+    };
+
+    /** Orders entries by their values. **/
+    struct EntryLess {
+        Compare compare;
+        bool operator() ( const Entry& lhs, const Entry& rhs ) const { return compare ( lhs.value, rhs.value ); }
+    };
+
+    /** The entries of the heap, live and dead. **/
+    MinimumHeap<Entry, Arity, Pop, EntryLess> _heap;
+
+    /** The flags of the entries, indexed by slot. **/
+    std::vector<Slot> _slots;
+
+    /** The slots that are not currently in use. **/
+    std::vector<size_t> _freeSlots;
+
+    /** The number of dead entries in the heap. **/
+    size_t _dead;
+
+    /** The fraction of dead entries which triggers a compaction. **/
+    double _threshold;
+
+    /**
+     * Releases the slot of an entry which has left the heap.
+     * @param slot: the slot of the entry.
+     */
+    void release ( size_t slot );
+
+    /**
+     * Pops the dead entries at the top of the heap, so that its top is live.
+     */
+    void dropDead ( );
+
+    /**
+     * Inserts the given element in a new slot.
+     * @return the handle of the inserted element.
+     */
+    Handle append ( Comparable&& element );
+
+public:
+
+    /**
+     * Instantiate an empty TombstoneMinimumHeap.
+     * @param threshold: the fraction of dead elements in the heap above which
+     * it is compacted (1 compacts only through compact()).
+     * @param capacity: the initial capacity.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit TombstoneMinimumHeap ( double threshold = 0.5, size_t capacity = 2,
+                                    const Compare& compare = Compare() );
+
+    /**
+     * Produces the number of live elements in the heap.
+     * @return number of elements in the TombstoneMinimumHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Determines if the TombstoneMinimumHeap has no live element.
+     * @return true if the TombstoneMinimumHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Produces the number of dead elements still held by the heap.
+     * @return the number of tombstones.
+     */
+    size_t tombstones() const;
+
+    /**
+     * Resets the TombstoneMinimumHeap to be empty. All existing handles
+     * become invalid.
+     */
+    void clear();
+
+    /**
+     * Produces the smallest live element without removing it from the heap.
+     * @return the value of the smallest live element.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Inserts the given element into the heap.
+     * @param element: the element to be inserted into the heap
+     * @return the handle of the inserted element.
+     */
+    Handle insert ( const Comparable& element );
+
+    /**
+     * Inserts the given element into the heap by moving it.
+     * @param element: the element to be inserted (moved) into the heap
+     * @return the handle of the inserted element.
+     */
+    Handle insert ( Comparable&& element );
+
+    /**
+     * Determines if the given handle refers to a live element in the heap.
+     * @param handle: the handle to check.
+     * @return true if the element is in the heap and not deleted.
+     */
+    bool contains ( const Handle& handle ) const;
+
+    /**
+     * Cancels the element referred to by the given handle, in O(1): it is
+     * no longer counted, produced by top() or pop(). Deleting the top element
+     * drops the dead elements at the top, and passing the threshold compacts
+     * the heap (amortized O(1) per deleted element).
+     * @param handle: the handle of the element.
+     * @return true if the element was deleted, false if it had already left
+     * the heap or been deleted.
+     */
+    bool mark_deleted ( const Handle& handle );
+
+    /**
+     * Removes every live element for which the given predicate holds, and
+     * every dead element, in one compaction of the heap.
+     * @param predicate: called once on each live element (as a const
+     * Comparable&); returns true for the elements to be removed.
+     * @return the number of live elements removed.
+     */
+    template <typename Predicate>
+    size_t erase_if ( Predicate predicate );
+
+    /**
+     * Removes every dead element from the heap (see MinimumHeap::erase_if).
+     */
+    void compact ( );
+
+    /**
+     * Produces the smallest live element and removes it from the heap.
+     * @return the value of the smallest live element.
+     * @throws MinimumHeapUnderflowException if the heap is empty
+     */
+    Comparable pop ();
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "tombstoneminimumheap.tpp"
+
+#endif // TOMBSTONEMINIMUMHEAP_H
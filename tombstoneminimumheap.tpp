@@ -0,0 +1,169 @@
+#include "tombstoneminimumheap.h"
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::release ( size_t slot )
+{
+    if ( _slots[slot].dead )
+        _dead--;
+    _slots[slot].live = false;
+    _slots[slot].dead = false;
+    _slots[slot].generation++;
+    _freeSlots.push_back ( slot );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::dropDead ( )
+{
+    while ( !_heap.empty() && _slots[_heap.top().slot].dead )
+        release ( _heap.pop().slot );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::append ( Comparable&& element )
+{
+    size_t slot;
+    if ( _freeSlots.empty() )
+    {
+        slot = _slots.size();
+        _slots.push_back ( Slot { 0, false, false } );
+    }
+    else
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    _slots[slot].live = true;
+    _heap.insert ( Entry { std::move ( element ), slot } );
+    return Handle ( slot, _slots[slot].generation );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::TombstoneMinimumHeap ( double threshold, size_t capacity,
+                                                                             const Compare& compare )
+    : _heap ( capacity, EntryLess { compare } ), _dead { 0 }, _threshold { threshold }
+{
+    _slots.reserve ( capacity );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::size() const
+{
+    return _heap.size() - _dead;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+size_t TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::tombstones() const
+{
+    return _dead;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::clear()
+{
+    _freeSlots.clear();
+    for ( size_t slot = 0; slot < _slots.size(); slot++ )
+    {
+        if ( _slots[slot].live )
+        {
+            _slots[slot].live = false;
+            _slots[slot].dead = false;
+            _slots[slot].generation++;
+        }
+        _freeSlots.push_back ( slot );
+    }
+    _heap.clear();
+    _dead = 0;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+const Comparable& TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::top ( ) const
+{
+    // The dead entries at the top are dropped as soon as they are deleted or
+    // reach the top, so the top entry is always live.
+    if ( _heap.empty() ) { throw MinimumHeapUnderflowException(); }
+    return _heap.top().value;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::insert ( const Comparable& element )
+{
+    return append ( Comparable ( element ) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+typename TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::Handle
+TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::insert ( Comparable&& element )
+{
+    return append ( std::move ( element ) );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::contains ( const Handle& handle ) const
+{
+    return handle._slot < _slots.size()
+            && _slots[handle._slot].generation == handle._generation
+            && _slots[handle._slot].live && !_slots[handle._slot].dead;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+bool TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::mark_deleted ( const Handle& handle )
+{
+    if ( !contains ( handle ) )
+        return false;
+    _slots[handle._slot].dead = true;
+    _dead++;
+    if ( _heap.top().slot == handle._slot )
+        dropDead();
+    else if ( _dead > _threshold * _heap.size() )
+        compact();
+    return true;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+template <typename Predicate>
+size_t TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::erase_if ( Predicate predicate )
+{
+    size_t erased = 0;
+    _heap.erase_if ( [this, &predicate, &erased] ( const Entry& entry )
+    {
+        bool dead = _slots[entry.slot].dead;
+        if ( !dead && !predicate ( static_cast<const Comparable&> ( entry.value ) ) )
+            return false;
+        erased += dead ? 0 : 1;
+        release ( entry.slot );
+        return true;
+    } );
+    return erased;
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+void TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::compact ( )
+{
+    if ( _dead == 0 )
+        return;
+    _heap.erase_if ( [this] ( const Entry& entry )
+    {
+        if ( !_slots[entry.slot].dead )
+            return false;
+        release ( entry.slot );
+        return true;
+    } );
+}
+
+template <typename Comparable, size_t Arity, MinimumHeapPop Pop, typename Compare>
+Comparable TombstoneMinimumHeap<Comparable, Arity, Pop, Compare>::pop ()
+{
+    if ( _heap.empty() ) { throw MinimumHeapUnderflowException(); }
+    Entry min = _heap.pop();
+    release ( min.slot );
+    dropDead();
+    return std::move ( min.value );
+}
@@ -0,0 +1,118 @@
+#ifndef TOPKHEAP_H
+#define TOPKHEAP_H
+
+#include <vector>
+#include <functional>
+#include "minimumheap.h"
+
+/**
+ * A fixed-capacity heap which keeps the K largest of a stream of Comparable
+ * elements (for example the K best scores seen so far).
+ *
+ * The kept elements are held in a MinimumHeap whose top is the smallest of
+ * them, i.e. the threshold a new element must beat to be kept. Once K elements
+ * are held, an element that does not beat the threshold is rejected after a
+ * single comparison, and one that does replaces the threshold with a single
+ * sift down (see MinimumHeap::replace_top); only a kept element is copied or
+ * moved into the heap. The underlying vector is allocated for K elements on
+ * construction and never grows.
+ *
+ * Elements are ordered by the Compare function object (default = std::less);
+ * with std::greater the heap keeps the K smallest elements instead.
+ *
+ * @author Ken Loomis (https://github.com/kjloomis3)
+ */
+template <typename Comparable, size_t Arity = 2,
+          typename Compare = std::less<Comparable>> class TopKHeap {
+
+private:
+
+    /** The kept elements, the smallest at the top. **/
+    MinimumHeap<Comparable, Arity, MinimumHeapPop::TopDown, Compare> _heap;
+
+    /** The number of elements to keep. **/
+    size_t _k;
+
+    /** The function object used to order the elements. **/
+    Compare _compare;
+
+public:
+
+    /**
+     * Instantiate a TopKHeap keeping the k largest elements.
+     * @param k: the number of elements to keep.
+     * @param compare: the function object used to order the elements.
+    **/
+    explicit TopKHeap ( size_t k, const Compare& compare = Compare() );
+
+    /**
+     * Produces the number of elements currently kept.
+     * @return number of elements in the TopKHeap.
+     */
+    size_t size() const;
+
+    /**
+     * Produces the number of elements the TopKHeap keeps (K).
+     * @return the capacity of the TopKHeap.
+     */
+    size_t capacity() const;
+
+    /**
+     * Determines if the TopKHeap is empty (it keeps no elements).
+     * @return true if the TopKHeap is empty, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Determines if the TopKHeap keeps K elements, i.e. further elements must
+     * beat the threshold to be kept.
+     * @return true if the TopKHeap is full, false otherwise.
+     */
+    bool full() const;
+
+    /**
+     * Discards every kept element. The capacity is unchanged and no memory is
+     * released or allocated.
+     */
+    void clear();
+
+    /**
+     * Produces the smallest element kept, the threshold a new element must
+     * beat once the TopKHeap is full.
+     * @return the smallest element kept.
+     * @throws MinimumHeapUnderflowException if the TopKHeap is empty
+     */
+    const Comparable& top ( ) const;
+
+    /**
+     * Offers the given element to the TopKHeap. It is kept if fewer than K
+     * elements are kept, or if it is larger than the smallest element kept, in
+     * which case that element is discarded.
+     * @param element: the element offered.
+     * @return true if the element was kept, false if it was rejected.
+     */
+    bool offer ( const Comparable& element );
+
+    /**
+     * Offers (moves) the given element to the TopKHeap. It is kept if fewer
+     * than K elements are kept, or if it is larger than the smallest element
+     * kept, in which case that element is discarded.
+     * @param element: the element offered.
+     * @return true if the element was kept, false if it was rejected.
+     */
+    bool offer ( Comparable&& element );
+
+    /**
+     * Removes every kept element, producing them from the largest to the
+     * smallest.
+     * @return the kept elements in descending order.
+     */
+    std::vector<Comparable> take ( );
+
+};
+
+/** Includes the templated class implementation to be compiled during usage of
+ * the class. **/
+#include "topkheap.tpp"
+
+#endif // TOPKHEAP_H
@@ -0,0 +1,80 @@
+#include "topkheap.h"
+
+template <typename Comparable, size_t Arity, typename Compare>
+TopKHeap<Comparable, Arity, Compare>::TopKHeap ( size_t k, const Compare& compare )
+    : _heap ( k, compare ), _k { k }, _compare { compare } {}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t TopKHeap<Comparable, Arity, Compare>::size() const
+{
+    return _heap.size();
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+size_t TopKHeap<Comparable, Arity, Compare>::capacity() const
+{
+    return _k;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool TopKHeap<Comparable, Arity, Compare>::empty() const
+{
+    return _heap.empty();
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool TopKHeap<Comparable, Arity, Compare>::full() const
+{
+    return _heap.size() == _k;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+void TopKHeap<Comparable, Arity, Compare>::clear()
+{
+    _heap.clear();
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+const Comparable& TopKHeap<Comparable, Arity, Compare>::top ( ) const
+{
+    return _heap.top();
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool TopKHeap<Comparable, Arity, Compare>::offer ( const Comparable& element )
+{
+    // Rejected elements, most of a long stream, are never copied.
+    if ( !full() )
+    {
+        _heap.insert ( element );
+        return true;
+    }
+    if ( _k == 0 || !_compare ( _heap.top(), element ) )
+        return false;
+    _heap.replace_top ( element );
+    return true;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+bool TopKHeap<Comparable, Arity, Compare>::offer ( Comparable&& element )
+{
+    if ( !full() )
+    {
+        _heap.insert ( std::move ( element ) );
+        return true;
+    }
+    if ( _k == 0 || !_compare ( _heap.top(), element ) )
+        return false;
+    _heap.replace_top ( std::move ( element ) );
+    return true;
+}
+
+template <typename Comparable, size_t Arity, typename Compare>
+std::vector<Comparable> TopKHeap<Comparable, Arity, Compare>::take ( )
+{
+    std::vector<Comparable> kept;
+    kept.reserve ( _heap.size() );
+    _heap.pop_n ( _heap.size(), std::back_inserter ( kept ) );
+    std::reverse ( kept.begin(), kept.end() );
+    return kept;
+}